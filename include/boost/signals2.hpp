@@ -12,12 +12,21 @@
 
 // For documentation, see http://www.boost.org/libs/signals2/
 
+#include <boost/signals2/connection_batch.hpp>
+#include <boost/signals2/connection_handle.hpp>
+#include <boost/signals2/connection_set.hpp>
 #include <boost/signals2/deconstruct.hpp>
 #include <boost/signals2/deconstruct_ptr.hpp>
 #include <boost/signals2/dummy_mutex.hpp>
+#include <boost/signals2/garbage_collection.hpp>
+#include <boost/signals2/inplace_function.hpp>
 #include <boost/signals2/last_value.hpp>
+#include <boost/signals2/pool_allocator.hpp>
+#include <boost/signals2/rcu_mutex.hpp>
 #include <boost/signals2/signal.hpp>
 #include <boost/signals2/signal_type.hpp>
 #include <boost/signals2/shared_connection_block.hpp>
+#include <boost/signals2/single_threaded.hpp>
+#include <boost/signals2/slot_storage.hpp>
 
 #endif
@@ -0,0 +1,336 @@
+// Asynchronous emission of a signal through a bounded queue, with the
+// slots run by an executor.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_ASYNC_EMITTER_HPP
+#define BOOST_SIGNALS2_ASYNC_EMITTER_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && \
+  !defined(BOOST_NO_CXX11_HDR_FUTURE) && !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+  !defined(BOOST_NO_CXX11_HDR_MUTEX) && !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+
+#include <boost/assert.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/optional.hpp>
+#include <boost/signals2/detail/variadic_slot_invoker.hpp>
+#include <boost/signals2/executors.hpp>
+#include <boost/throw_exception.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace boost {
+  namespace signals2 {
+    // what async_emitter does with an emission when its queue is full
+    enum overflow_policy
+    {
+      block_on_overflow,
+      drop_oldest_on_overflow,
+      fail_on_overflow
+    };
+
+    // thrown by async_emitter when fail_on_overflow rejects an emission
+    class emission_queue_full: public std::exception
+    {
+    public:
+      virtual char const * what() const throw()
+      {
+        return "boost::signals2::emission_queue_full";
+      }
+    };
+
+    // the exception held by the future of an emission dropped by drop_oldest_on_overflow
+    class emission_dropped: public std::exception
+    {
+    public:
+      virtual char const * what() const throw()
+      {
+        return "boost::signals2::emission_dropped";
+      }
+    };
+
+    namespace detail {
+      template<typename ResultType, typename Signature> class async_emission;
+
+      // one queued emission: its arguments, moved in when it was queued,
+      // and the promise of its result if anyone asked for it
+      template<typename ResultType, typename R, typename ... Args>
+      class async_emission<ResultType, R (Args...)>
+      {
+      public:
+        typedef std::tuple<typename std::decay<Args>::type...> arguments_type;
+
+        template<typename ... A>
+        explicit async_emission(A && ... args): _args(std::forward<A>(args)...)
+        {}
+        std::future<ResultType> get_future()
+        {
+          _promise.emplace();
+          return _promise->get_future();
+        }
+        template<typename Signal>
+        void operator()(Signal &sig)
+        {
+          typedef typename make_unsigned_meta_array<sizeof...(Args)>::type indices_type;
+          if(_promise)
+          {
+            try
+            {
+              invoke(sig, indices_type(), std::is_void<ResultType>());
+            }
+            catch(...)
+            {
+              _promise->set_exception(std::current_exception());
+            }
+          }else
+          {
+            // there is nobody to report an exception to
+            try
+            {
+              call(sig, indices_type());
+            }
+            catch(...)
+            {}
+          }
+        }
+        void drop()
+        {
+          if(_promise)
+            _promise->set_exception(std::make_exception_ptr(emission_dropped()));
+        }
+      private:
+        template<typename Signal, unsigned ... indices>
+        void invoke(Signal &sig, unsigned_meta_array<indices...> indices_arg, std::false_type /* void result */)
+        {
+          _promise->set_value(call(sig, indices_arg));
+        }
+        template<typename Signal, unsigned ... indices>
+        void invoke(Signal &sig, unsigned_meta_array<indices...> indices_arg, std::true_type /* void result */)
+        {
+          call(sig, indices_arg);
+          _promise->set_value();
+        }
+        // arguments the signal takes by value are moved out of the queue
+        template<typename Signal, unsigned ... indices>
+        ResultType call(Signal &sig, unsigned_meta_array<indices...>)
+        {
+          return sig(std::forward<Args>(std::get<indices>(_args))...);
+        }
+
+        arguments_type _args;
+        boost::optional<std::promise<ResultType> > _promise;
+      };
+    } // namespace detail
+
+    /* Queues emissions of a signal and has an executor run them, so with an
+    executor such as thread_pool_executor the emitting thread doesn't wait
+    for the slots.  Emissions run one at a
+    time in the order they were queued, each invoking the signal's slots and
+    combiner as usual.  The signal and executor must outlive the emitter,
+    whose destructor waits for the queued emissions to finish, and drops any
+    left queued because the executor refused to take a task for them. */
+    template<typename Signal, typename Executor = thread_pool_executor>
+    class async_emitter: noncopyable
+    {
+      typedef detail::async_emission<typename Signal::result_type,
+        typename Signal::signature_type> emission_type;
+    public:
+      typedef Signal signal_type;
+      typedef Executor executor_type;
+      typedef typename Signal::result_type result_type;
+      // emissions run per task given to the executor, before it gets another
+      BOOST_STATIC_CONSTANT(std::size_t, emissions_per_task = 64);
+
+      async_emitter(signal_type &sig, executor_type &executor, std::size_t capacity,
+        overflow_policy policy = block_on_overflow):
+        _signal(sig), _executor(executor), _capacity(capacity), _policy(policy),
+        _front_sequence(0), _running(false)
+      {
+        BOOST_ASSERT(capacity > 0);
+      }
+      ~async_emitter()
+      {
+        std::deque<emission_type> stranded;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          while(_running)
+            _idle.wait(lock);
+          // nothing will run what a refused task left behind
+          stranded.swap(_queue);
+        }
+        for(typename std::deque<emission_type>::iterator it = stranded.begin(); it != stranded.end(); ++it)
+          it->drop();
+      }
+      // queues an emission and returns the future of the combiner's result
+      template<typename ... A>
+      std::future<result_type> async_emit(A && ... args)
+      {
+        emission_type emission(std::forward<A>(args)...);
+        std::future<result_type> result = emission.get_future();
+        if(enqueue(emission) == false)
+          boost::throw_exception(emission_queue_full());
+        return result;
+      }
+      // queues an emission whose result is discarded, returning false if
+      // it was rejected by fail_on_overflow, or by a full queue it was
+      // posted to from one of the signal's slots
+      template<typename ... A>
+      bool post(A && ... args)
+      {
+        emission_type emission(std::forward<A>(args)...);
+        return enqueue(emission);
+      }
+      // the number of emissions queued and not yet started
+      std::size_t size() const
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _queue.size();
+      }
+      std::size_t capacity() const {return _capacity;}
+      overflow_policy policy() const {return _policy;}
+    private:
+      bool enqueue(emission_type &emission)
+      {
+        boost::optional<emission_type> dropped;
+        bool start;
+        std::size_t sequence;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          if(_queue.size() >= _capacity)
+          {
+            switch(_policy)
+            {
+            case block_on_overflow:
+              // a slot queueing onto its own full emitter would wait for itself
+              if(_runner == std::this_thread::get_id()) return false;
+              while(_queue.size() >= _capacity)
+                _not_full.wait(lock);
+              break;
+            case drop_oldest_on_overflow:
+              dropped.emplace(std::move(_queue.front()));
+              nolock_pop_front();
+              break;
+            case fail_on_overflow:
+              return false;
+            }
+          }
+          _queue.push_back(std::move(emission));
+          sequence = _front_sequence + _queue.size() - 1;
+          start = _running == false;
+          _running = true;
+        }
+        if(dropped) dropped->drop();
+        if(start == false) return true;
+        try
+        {
+          schedule();
+        }
+        catch(...)
+        {
+          // the caller sees the emission fail, so it mustn't stay queued
+          std::unique_lock<std::mutex> lock(_mutex);
+          nolock_retract(sequence - _front_sequence);
+          nolock_stop();
+          throw;
+        }
+        return true;
+      }
+      void schedule()
+      {
+        _executor.execute(std::bind(&async_emitter::run, this));
+      }
+      // after the executor refused a task, leaves the queue for the next
+      // emission to schedule
+      void nolock_stop()
+      {
+        _running = false;
+        _idle.notify_all();
+      }
+      // removes the emission at position, if it is still queued.  Emissions
+      // can't be assigned, so the rest are moved to a new queue.
+      void nolock_retract(std::size_t position)
+      {
+        if(position >= _queue.size()) return;
+        std::deque<emission_type> rest;
+        for(std::size_t i = 0; i < _queue.size(); ++i)
+          if(i != position) rest.push_back(std::move(_queue[i]));
+        _queue.swap(rest);
+      }
+      void nolock_pop_front()
+      {
+        _queue.pop_front();
+        ++_front_sequence;
+      }
+      // runs queued emissions, handing the executor back a new task after a
+      // while so other work submitted to it gets a turn
+      void run()
+      {
+        for(std::size_t i = 0;; ++i)
+        {
+          boost::optional<emission_type> emission;
+          {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _runner = std::thread::id();
+            if(_queue.empty())
+            {
+              _running = false;
+              _idle.notify_all();
+              return;
+            }
+            if(i == emissions_per_task) break;
+            emission.emplace(std::move(_queue.front()));
+            nolock_pop_front();
+            _runner = std::this_thread::get_id();
+          }
+          _not_full.notify_one();
+          (*emission)(_signal);
+        }
+        try
+        {
+          schedule();
+        }
+        catch(...)
+        {
+          // nothing on the executor's thread can handle the failure
+          std::unique_lock<std::mutex> lock(_mutex);
+          nolock_stop();
+        }
+      }
+
+      signal_type &_signal;
+      executor_type &_executor;
+      const std::size_t _capacity;
+      const overflow_policy _policy;
+      mutable std::mutex _mutex;
+      std::condition_variable _not_full;
+      std::condition_variable _idle;
+      std::deque<emission_type> _queue;
+      // the number of emissions ever taken from the front of _queue
+      std::size_t _front_sequence;
+      // the thread running an emission, if any
+      std::thread::id _runner;
+      // true while a task given to the executor is, or will be, running the queue
+      bool _running;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // C++11 threads and variadic templates
+
+#endif // BOOST_SIGNALS2_ASYNC_EMITTER_HPP
@@ -14,16 +14,29 @@
 #ifndef BOOST_SIGNALS2_CONNECTION_HPP
 #define BOOST_SIGNALS2_CONNECTION_HPP
 
+#include <boost/assert.hpp>
 #include <boost/config.hpp>
 #include <boost/core/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/enable_shared_from_this.hpp>
 #include <boost/function.hpp>
 #include <boost/mpl/bool.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/atomic.hpp>
 #include <boost/signals2/detail/auto_buffer.hpp>
 #include <boost/signals2/detail/null_output_iterator.hpp>
+#include <boost/signals2/detail/slot_table.hpp>
 #include <boost/signals2/detail/unique_lock.hpp>
+#include <boost/signals2/single_threaded.hpp>
 #include <boost/signals2/slot.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/is_empty.hpp>
 #include <boost/weak_ptr.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <new>
 
 namespace boost
 {
@@ -32,7 +45,26 @@ namespace boost
     inline void null_deleter(const void*) {}
     namespace detail
     {
-      // This lock maintains a list of shared_ptr<void>
+      class connection_body_base;
+      class connection_access;
+      // Connection bodies whose slots have been released.  The slots
+      // are destroyed along with the list, each body is kept alive
+      // until then.
+      class released_slot_list: public noncopyable
+      {
+      public:
+        released_slot_list()
+        {}
+        ~released_slot_list();
+        void push_back(const shared_ptr<const connection_body_base> &body)
+        {
+          _bodies.push_back(body);
+        }
+      private:
+        auto_buffer<shared_ptr<const connection_body_base>, store_n_objects<10> > _bodies;
+      };
+
+      // This lock maintains a list of released slots
       // which will be destroyed only after the lock
       // has released its mutex.  Used to garbage
       // collect disconnected slots
@@ -43,61 +75,158 @@ namespace boost
         garbage_collecting_lock(Mutex &m):
           lock(m)
         {}
-        void add_trash(const shared_ptr<void> &piece_of_trash)
+        garbage_collecting_lock(Mutex &m, try_to_lock_t tag):
+          lock(m, tag)
+        {}
+        bool owns_lock() const {return lock.owns_lock();}
+        void add_trash(const shared_ptr<const connection_body_base> &released_slot_owner)
         {
-          garbage.push_back(piece_of_trash);
+          garbage.push_back(released_slot_owner);
         }
       private:
         // garbage must be declared before lock
         // to insure it is destroyed after lock is
         // destroyed.
-        auto_buffer<shared_ptr<void>, store_n_objects<10> > garbage;
+        released_slot_list garbage;
         unique_lock<Mutex> lock;
       };
       
-      class connection_body_base
+      // Counts of a signal's connected slots, kept up to date by its
+      // connection bodies so they can be read without walking the slot list.
+      class connection_counts: public noncopyable
       {
       public:
-        connection_body_base():
-          _connected(true), m_slot_refcount(1)
+        connection_counts(): connected(0), tracked(0), handles(0)
+        {}
+        ~connection_counts()
+        {
+          delete handles.load(memory_order_relaxed);
+        }
+        atomic<std::size_t> connected;
+        // connected slots with tracked objects, which may have expired
+        // without the slot being disconnected yet
+        atomic<std::size_t> tracked;
+        // created along with the first connection_handle to the signal
+        atomic<slot_table *> handles;
+      };
+
+      class connection_body_base: public enable_shared_from_this<connection_body_base>
+      {
+      public:
+        /* The whole state of a connection is packed into one word, so
+        invocations can check and update it with single atomic operations:
+          bit 0: connected
+          bit 1: the slot has tracked objects
+          bit 2: the signal is single_threaded, so the slot refcount is
+            updated with plain loads and stores
+          bits 3-31: number of blockers
+          bits 32-63: slot refcount */
+        typedef boost::uint64_t state_type;
+        BOOST_STATIC_CONSTANT(state_type, connected_flag = 1u);
+        BOOST_STATIC_CONSTANT(state_type, tracked_flag = 2u);
+        BOOST_STATIC_CONSTANT(state_type, single_threaded_flag = 4u);
+        BOOST_STATIC_CONSTANT(state_type, blocked_one = 8u);
+        BOOST_STATIC_CONSTANT(state_type, blocked_mask = 0xfffffff8u);
+        BOOST_STATIC_CONSTANT(state_type, slot_refcount_one = state_type(1) << 32);
+
+        explicit connection_body_base(std::size_t tracked_count = 0, connection_counts *counts = 0,
+          bool single_threaded = false):
+          _state(connected_flag | (tracked_count != 0 ? tracked_flag : 0) |
+            (single_threaded ? single_threaded_flag : 0) | slot_refcount_one),
+          _counts(counts),
+          _tracked_count(tracked_count),
+          _handle_index(0),
+          _handle_generation(0)
         {
         }
         virtual ~connection_body_base() {}
         void disconnect()
         {
-          garbage_collecting_lock<connection_body_base> local_lock(*this);
-          nolock_disconnect(local_lock);
+          state_type state = _state.load(memory_order_relaxed);
+          // drop our slot reference without locking unless it is the last one
+          while(state & connected_flag)
+          {
+            if(slot_refcount(state) == 1)
+            {
+              garbage_collecting_lock<connection_body_base> local_lock(*this);
+              nolock_disconnect(local_lock);
+              return;
+            }
+            if(_state.compare_exchange_weak(state, (state & ~connected_flag) - slot_refcount_one,
+              memory_order_release, memory_order_relaxed))
+            {
+              uncount(state);
+              return;
+            }
+          }
         }
         template<typename Mutex>
         void nolock_disconnect(garbage_collecting_lock<Mutex> &lock_arg) const
         {
-          if(_connected)
+          state_type state = _state.load(memory_order_relaxed);
+          do
+          {
+            if((state & connected_flag) == 0) return;
+          }while(_state.compare_exchange_weak(state, (state & ~connected_flag) - slot_refcount_one,
+            memory_order_acq_rel, memory_order_relaxed) == false);
+          uncount(state);
+          if(slot_refcount(state) == 1)
           {
-            _connected = false;
-            dec_slot_refcount(lock_arg);
+            lock_arg.add_trash(shared_from_this());
           }
         }
         virtual bool connected() const = 0;
-        shared_ptr<void> get_blocker()
+        // Called by the signal as the connection is made, and
+        // disconnecting takes it out of the counts again.
+        void nolock_count() const
         {
-          unique_lock<connection_body_base> local_lock(*this);
-          shared_ptr<void> blocker = _weak_blocker.lock();
-          if(blocker == shared_ptr<void>())
-          {
-            blocker.reset(this, &null_deleter);
-            _weak_blocker = blocker;
-          }
-          return blocker;
+          if(_counts == 0) return;
+          _counts->connected.fetch_add(1, memory_order_relaxed);
+          if(has_tracked_objects(_state.load(memory_order_relaxed)))
+            _counts->tracked.fetch_add(1, memory_order_relaxed);
+        }
+        // Each blocker holds one count in the state word, and gives it
+        // back when its last copy is destroyed.  self must own this
+        // connection body.
+        shared_ptr<void> get_blocker(const shared_ptr<connection_body_base> &self)
+        {
+          BOOST_ASSERT(self.get() == this);
+          _state.fetch_add(blocked_one);
+          return shared_ptr<void>(this, unblocker(self));
         }
         bool blocked() const
         {
-          return !_weak_blocker.expired();
+          return is_blocked(_state.load());
         }
         bool nolock_nograb_blocked() const
         {
-          return nolock_nograb_connected() == false || blocked();
+          return nolock_nograb_blocked(_state.load());
         }
-        bool nolock_nograb_connected() const {return _connected;}
+        bool nolock_nograb_connected() const {return is_connected(_state.load());}
+        static bool is_connected(state_type state) {return (state & connected_flag) != 0;}
+        static bool is_blocked(state_type state) {return (state & blocked_mask) != 0;}
+        static bool has_tracked_objects(state_type state) {return (state & tracked_flag) != 0;}
+        static bool nolock_nograb_blocked(state_type state)
+        {
+          return is_connected(state) == false || is_blocked(state);
+        }
+        state_type nolock_nograb_state() const {return _state.load();}
+        // the number of objects the slot tracks, which never changes
+        // once it is connected
+        std::size_t tracked_object_count() const {return _tracked_count;}
+        // the counts of the signal the connection belongs to, which also
+        // identify the signal, or null for a body not made by a signal
+        const connection_counts * counts() const {return _counts;}
+        // Gives the connection an entry in its signal's slot_table.  Called
+        // by the signal before anything else can see the connection.
+        void nolock_set_handle(boost::uint32_t index, boost::uint32_t generation)
+        {
+          BOOST_ASSERT(_counts != 0);
+          _handle_index = index;
+          _handle_generation = generation;
+        }
+        // the index of the connection's slot_table entry, or zero if it has none
+        boost::uint32_t handle_index() const {return _handle_index;}
         // expose part of Lockable concept of mutex
         virtual void lock() = 0;
         virtual void unlock() = 0;
@@ -105,60 +234,178 @@ namespace boost
         // Slot refcount should be incremented while
         // a signal invocation is using the slot, in order
         // to prevent slot from being destroyed mid-invocation.
-        // garbage_collecting_lock parameter enforces 
-        // the existance of a lock before this
-        // method is called
-        template<typename Mutex>
-        void inc_slot_refcount(const garbage_collecting_lock<Mutex> &)
+        // Fails without effect if the slot has already been released,
+        // otherwise state receives the state word from before the increment.
+        bool try_inc_slot_refcount(state_type &state)
         {
-          BOOST_ASSERT(m_slot_refcount != 0);
-          ++m_slot_refcount;
+          state = _state.load(memory_order_relaxed);
+          if(state & single_threaded_flag)
+          {
+            if(slot_refcount(state) == 0) return false;
+            _state.store(state + slot_refcount_one, memory_order_relaxed);
+            return true;
+          }
+          do
+          {
+            if(slot_refcount(state) == 0) return false;
+          }while(_state.compare_exchange_weak(state, state + slot_refcount_one,
+            memory_order_acquire, memory_order_relaxed) == false);
+          return true;
         }
         // if slot refcount decrements to zero due to this call, 
-        // it puts a
-        // shared_ptr to the slot in the garbage collecting lock,
+        // it puts this connection body
+        // in the garbage collecting lock,
         // which will destroy the slot only after it unlocks.
+        // garbage_collecting_lock parameter enforces 
+        // the existance of a lock before this
+        // method is called
         template<typename Mutex>
         void dec_slot_refcount(garbage_collecting_lock<Mutex> &lock_arg) const
         {
-          BOOST_ASSERT(m_slot_refcount != 0);
-          if(--m_slot_refcount == 0)
+          state_type old_state = _state.load(memory_order_relaxed);
+          if(old_state & single_threaded_flag)
+            _state.store(old_state - slot_refcount_one, memory_order_relaxed);
+          else
+            old_state = _state.fetch_sub(slot_refcount_one, memory_order_acq_rel);
+          BOOST_ASSERT(slot_refcount(old_state) != 0);
+          if(slot_refcount(old_state) == 1)
           {
-            lock_arg.add_trash(release_slot());
+            lock_arg.add_trash(shared_from_this());
+          }
+        }
+        // Drops a reference without locking, unless it is the last one.
+        // The slot is only ever released with the lock held, so code
+        // holding the lock may use the slot of a connected body without
+        // taking a reference.
+        void dec_slot_refcount()
+        {
+          state_type state = _state.load(memory_order_relaxed);
+          if((state & single_threaded_flag) && slot_refcount(state) > 1)
+          {
+            _state.store(state - slot_refcount_one, memory_order_relaxed);
+            return;
+          }
+          while(slot_refcount(state) > 1)
+          {
+            if(_state.compare_exchange_weak(state, state - slot_refcount_one,
+              memory_order_release, memory_order_relaxed))
+            {
+              return;
+            }
           }
+          garbage_collecting_lock<connection_body_base> local_lock(*this);
+          dec_slot_refcount(local_lock);
         }
 
       protected:
-        virtual shared_ptr<void> release_slot() const = 0;
+        friend class released_slot_list;
 
-        weak_ptr<void> _weak_blocker;
+        // Called outside the lock once the slot refcount has dropped to zero.
+        virtual void destroy_slot() const = 0;
+        bool nolock_slot_released() const {return slot_refcount(_state.load()) == 0;}
+        static state_type slot_refcount(state_type state) {return state >> 32;}
       private:
-        mutable bool _connected;
-        mutable unsigned m_slot_refcount;
+        // state is the state word from before disconnection
+        void uncount(state_type state) const
+        {
+          if(_counts == 0) return;
+          _counts->connected.fetch_sub(1, memory_order_relaxed);
+          if(has_tracked_objects(state))
+            _counts->tracked.fetch_sub(1, memory_order_relaxed);
+          if(_handle_index != 0)
+            _counts->handles.load(memory_order_acquire)->disconnect(_handle_index, _handle_generation);
+        }
+
+        // deleter of a blocker, which outlives the connection body if the
+        // signal is destroyed first
+        class unblocker
+        {
+        public:
+          unblocker(const weak_ptr<connection_body_base> &body): _body(body)
+          {}
+          void operator()(const void *) const
+          {
+            shared_ptr<connection_body_base> body(_body.lock());
+            if(body) body->_state.fetch_sub(blocked_one);
+          }
+        private:
+          weak_ptr<connection_body_base> _body;
+        };
+
+        mutable atomic<state_type> _state;
+        // owned by the signal's mutex, which the connection body keeps alive
+        connection_counts *const _counts;
+        const std::size_t _tracked_count;
+        boost::uint32_t _handle_index;
+        boost::uint32_t _handle_generation;
+      };
+
+      inline released_slot_list::~released_slot_list()
+      {
+        auto_buffer<shared_ptr<const connection_body_base>, store_n_objects<10> >::const_iterator it;
+        for(it = _bodies.begin(); it != _bodies.end(); ++it)
+        {
+          (*it)->destroy_slot();
+        }
+      }
+
+      // Holds the group key of a connection.  Signals without groups use an
+      // empty key type, which is not stored at all.
+      template<typename GroupKey, bool = is_empty<GroupKey>::value>
+      class group_key_holder
+      {
+      public:
+        const GroupKey& group_key() const {return _group_key;}
+        void set_group_key(const GroupKey &key) {_group_key = key;}
+      private:
+        GroupKey _group_key;
+      };
+      template<typename GroupKey>
+      class group_key_holder<GroupKey, true>
+      {
+      public:
+        GroupKey group_key() const {return GroupKey();}
+        void set_group_key(const GroupKey &) {}
       };
 
       template<typename GroupKey, typename SlotType, typename Mutex>
-      class connection_body: public connection_body_base
+      class connection_body: public connection_body_base, public group_key_holder<GroupKey>
       {
       public:
         typedef Mutex mutex_type;
-        connection_body(const SlotType &slot_in, const boost::shared_ptr<mutex_type> &signal_mutex):
-          m_slot(new SlotType(slot_in)), _mutex(signal_mutex)
+        connection_body(const SlotType &slot_in, const boost::shared_ptr<mutex_type> &signal_mutex,
+          connection_counts *counts = 0):
+          connection_body_base(slot_in.tracked_objects().size(), counts,
+            is_single_threaded<Mutex>::value),
+          _mutex(signal_mutex)
         {
+          new(_slot.address()) SlotType(slot_in);
+        }
+        virtual ~connection_body()
+        {
+          // a released slot has already been destroyed by whoever held
+          // the body in its garbage collecting lock
+          if(nolock_slot_released() == false)
+          {
+            slot().~SlotType();
+          }
         }
-        virtual ~connection_body() {}
         virtual bool connected() const
         {
+          const state_type state = nolock_nograb_state();
+          if(is_connected(state) == false) return false;
+          // only a tracked object expiring can disconnect us behind our back
+          if(has_tracked_objects(state) == false) return true;
           garbage_collecting_lock<mutex_type> local_lock(*_mutex);
           nolock_grab_tracked_objects(local_lock, detail::null_output_iterator());
           return nolock_nograb_connected();
         }
-        const GroupKey& group_key() const {return _group_key;}
-        void set_group_key(const GroupKey &key) {_group_key = key;}
         template<typename M>
         void disconnect_expired_slot(garbage_collecting_lock<M> &lock_arg)
         {
-          if(!m_slot) return;
+          const state_type state = nolock_nograb_state();
+          // untracked slots never expire
+          if(has_tracked_objects(state) == false || slot_refcount(state) == 0) return;
           bool expired = slot().expired();
           if(expired == true)
           {
@@ -169,7 +416,7 @@ namespace boost
         void nolock_grab_tracked_objects(garbage_collecting_lock<M> &lock_arg,
           OutputIterator inserter) const
         {
-          if(!m_slot) return;
+          if(nolock_slot_released()) return;
           slot_base::tracked_container_type::const_iterator it;
           for(it = slot().tracked_objects().begin();
             it != slot().tracked_objects().end();
@@ -202,24 +449,22 @@ namespace boost
         }
         SlotType &slot()
         {
-          return *m_slot;
+          return *static_cast<SlotType *>(_slot.address());
         }
         const SlotType &slot() const
         {
-          return *m_slot;
+          return *static_cast<const SlotType *>(_slot.address());
         }
       protected:
-        virtual shared_ptr<void> release_slot() const
+        virtual void destroy_slot() const
         {
-          
-          shared_ptr<void> released_slot = m_slot;
-          m_slot.reset();
-          return released_slot;
+          static_cast<SlotType *>(_slot.address())->~SlotType();
         }
       private:
-        mutable boost::shared_ptr<SlotType> m_slot;
+        // The slot lives inside the connection body, so creating a
+        // connection with make_shared takes a single allocation.
+        mutable typename aligned_storage<sizeof(SlotType), alignment_of<SlotType>::value>::type _slot;
         const boost::shared_ptr<mutex_type> _mutex;
-        GroupKey _group_key;
       };
     }
 
@@ -229,6 +474,7 @@ namespace boost
     {
     public:
       friend class shared_connection_block;
+      friend class detail::connection_access;
 
       connection() BOOST_NOEXCEPT {}
       connection(const connection &other) BOOST_NOEXCEPT: _weak_connection_body(other._weak_connection_body)
@@ -369,6 +615,52 @@ namespace boost
     {
       conn1.swap(conn2);
     }
+
+    namespace detail
+    {
+      // lets the library reach the connection body behind a connection
+      class connection_access
+      {
+      public:
+        static shared_ptr<connection_body_base> body(const connection &conn)
+        {
+          return conn._weak_connection_body.lock();
+        }
+      };
+
+      // orders connection bodies so those of the same signal are adjacent
+      class signal_order
+      {
+      public:
+        bool operator()(const shared_ptr<connection_body_base> &a,
+          const shared_ptr<connection_body_base> &b) const
+        {
+          return std::less<const connection_counts *>()(a->counts(), b->counts());
+        }
+      };
+
+      // Disconnects the connection bodies in [first, last), which are
+      // reordered so each signal's mutex is locked only once for all of its
+      // connections.  The released slots are destroyed after each unlock.
+      template<typename RandomAccessIterator>
+      void disconnect_by_signal(RandomAccessIterator first, RandomAccessIterator last)
+      {
+        std::sort(first, last, signal_order());
+        while(first != last)
+        {
+          RandomAccessIterator signal_end = first;
+          ++signal_end;
+          if((*first)->counts() != 0)
+          {
+            while(signal_end != last && (*signal_end)->counts() == (*first)->counts())
+              ++signal_end;
+          }
+          garbage_collecting_lock<connection_body_base> lock(**first);
+          for(; first != signal_end; ++first)
+            (*first)->nolock_disconnect(lock);
+        }
+      }
+    } // namespace detail
   }
 }
 
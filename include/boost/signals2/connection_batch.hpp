@@ -0,0 +1,80 @@
+// Connecting and disconnecting many slots of a signal at once.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_CONNECTION_BATCH_HPP
+#define BOOST_SIGNALS2_CONNECTION_BATCH_HPP
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/connection.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    /* Collects connections to, and disconnections from, a signal, and makes
+    them all at once when committed: the signal's mutex is locked once, and
+    its slot list is copied at most once, however many slots the batch
+    holds.  The connections returned by connect are connected from the
+    start, but their slots are not invoked until the batch is committed.
+    Destroying a batch which has not been committed disconnects them. */
+    template<typename Signal>
+    class connection_batch: noncopyable
+    {
+      typedef typename Signal::impl_class impl_class;
+    public:
+      typedef Signal signal_type;
+      typedef typename signal_type::slot_type slot_type;
+      typedef typename signal_type::group_type group_type;
+
+      explicit connection_batch(signal_type &sig): _impl(sig.shared_pimpl())
+      {}
+      ~connection_batch()
+      {
+        rollback();
+      }
+      connection connect(const slot_type &slot, connect_position position = at_back)
+      {
+        return _impl->add_pending_connection(_pending, slot, position);
+      }
+      connection connect(const group_type &group,
+        const slot_type &slot, connect_position position = at_back)
+      {
+        return _impl->add_pending_connection(_pending, group, slot, position);
+      }
+      // disconnects conn when the batch is committed
+      void disconnect(const connection &conn)
+      {
+        _disconnections.push_back(conn);
+      }
+      void commit()
+      {
+        _impl->commit_batch(_pending, _disconnections);
+        _disconnections.clear();
+      }
+      // disconnects the connections made since the last commit, and forgets
+      // the disconnections
+      void rollback()
+      {
+        _impl->cancel_batch(_pending);
+        _disconnections.clear();
+      }
+      // the number of connections and disconnections waiting to be committed
+      std::size_t size() const {return _pending.size() + _disconnections.size();}
+      bool empty() const {return size() == 0;}
+    private:
+      const shared_ptr<impl_class> _impl;
+      typename impl_class::pending_connection_list _pending;
+      std::vector<connection> _disconnections;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_CONNECTION_BATCH_HPP
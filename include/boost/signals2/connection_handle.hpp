@@ -0,0 +1,49 @@
+// A compact handle to a connection, resolved through the signal it
+// belongs to.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_CONNECTION_HANDLE_HPP
+#define BOOST_SIGNALS2_CONNECTION_HANDLE_HPP
+
+#include <boost/cstdint.hpp>
+
+namespace boost {
+  namespace signals2 {
+    /* Identifies a connection made by signal::connect_handle as the index of
+    its entry in the signal's slot table and the generation of that entry.
+    A handle is a plain 64-bit value: copying and comparing handles involves
+    no reference counts, and a handle left over from a connection which has
+    since been cleaned up never matches a later connection.  Whether the
+    connection is connected, and the connection object itself, are found by
+    passing the handle to the signal. */
+    class connection_handle
+    {
+    public:
+      connection_handle(): _value(0)
+      {}
+      explicit connection_handle(boost::uint64_t value): _value(value)
+      {}
+      connection_handle(boost::uint32_t index, boost::uint32_t generation):
+        _value((boost::uint64_t(generation) << 32) | index)
+      {}
+      boost::uint64_t value() const {return _value;}
+      boost::uint32_t index() const {return static_cast<boost::uint32_t>(_value);}
+      boost::uint32_t generation() const {return static_cast<boost::uint32_t>(_value >> 32);}
+      // a default constructed handle never refers to a connection
+      bool null() const {return _value == 0;}
+      bool operator==(const connection_handle &other) const {return _value == other._value;}
+      bool operator!=(const connection_handle &other) const {return _value != other._value;}
+      bool operator<(const connection_handle &other) const {return _value < other._value;}
+    private:
+      boost::uint64_t _value;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_CONNECTION_HANDLE_HPP
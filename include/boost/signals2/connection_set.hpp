@@ -0,0 +1,69 @@
+// A set of connections which are disconnected together.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_CONNECTION_SET_HPP
+#define BOOST_SIGNALS2_CONNECTION_SET_HPP
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/connection.hpp>
+#include <cstddef>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    /* Owns a set of connections, possibly to several signals, and
+    disconnects them all when it is destroyed.  Disconnecting the set locks
+    each signal's mutex once for all of its connections, instead of once
+    per connection. */
+    class connection_set: noncopyable
+    {
+    public:
+      connection_set()
+      {}
+      ~connection_set()
+      {
+        disconnect();
+      }
+      void add(const connection &conn)
+      {
+        _connections.push_back(conn);
+      }
+      connection_set & operator+=(const connection &conn)
+      {
+        add(conn);
+        return *this;
+      }
+      // disconnects every connection in the set and empties it
+      void disconnect()
+      {
+        std::vector<shared_ptr<detail::connection_body_base> > bodies;
+        bodies.reserve(_connections.size());
+        for(std::size_t i = 0; i < _connections.size(); ++i)
+        {
+          shared_ptr<detail::connection_body_base> body(detail::connection_access::body(_connections[i]));
+          if(body) bodies.push_back(body);
+        }
+        _connections.clear();
+        detail::disconnect_by_signal(bodies.begin(), bodies.end());
+      }
+      // empties the set without disconnecting anything
+      void release()
+      {
+        _connections.clear();
+      }
+      std::size_t size() const {return _connections.size();}
+      bool empty() const {return _connections.empty();}
+    private:
+      std::vector<connection> _connections;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_CONNECTION_SET_HPP
@@ -0,0 +1,48 @@
+/*
+  Selects std::atomic when the compiler provides <atomic>, and falls back
+  to Boost.Atomic otherwise.
+*/
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_DETAIL_ATOMIC_HPP
+#define BOOST_SIGNALS2_DETAIL_ATOMIC_HPP
+
+#include <boost/config.hpp>
+
+#ifdef BOOST_NO_CXX11_HDR_ATOMIC
+#include <boost/atomic/atomic.hpp>
+#else
+#include <atomic>
+#endif
+
+namespace boost
+{
+  namespace signals2
+  {
+    namespace detail
+    {
+#ifdef BOOST_NO_CXX11_HDR_ATOMIC
+      using boost::atomic;
+      using boost::memory_order_relaxed;
+      using boost::memory_order_acquire;
+      using boost::memory_order_release;
+      using boost::memory_order_acq_rel;
+      using boost::memory_order_seq_cst;
+#else
+      using std::atomic;
+      using std::memory_order_relaxed;
+      using std::memory_order_acquire;
+      using std::memory_order_release;
+      using std::memory_order_acq_rel;
+      using std::memory_order_seq_cst;
+#endif
+    } // namespace detail
+  } // namespace signals2
+} // namespace boost
+
+#endif // BOOST_SIGNALS2_DETAIL_ATOMIC_HPP
@@ -484,7 +484,8 @@ namespace detail
         }
 
         auto_buffer( const auto_buffer& r )
-            : members_( (std::max)(r.size_,size_type(N)) ),
+            : Allocator( r ),
+              members_( (std::max)(r.size_,size_type(N)) ),
               buffer_( allocate( members_.capacity_ ) ),
               size_( 0 )
         {
@@ -13,10 +13,13 @@
 
 #include <algorithm>
 #include <boost/config.hpp>
-#include <boost/core/invoke_swap.hpp>
 #include <boost/assert.hpp>
-#include <boost/scoped_ptr.hpp>
 #include <boost/smart_ptr/bad_weak_ptr.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <cstddef>
+#include <new>
 
 #ifndef BOOST_NO_CXX11_SMART_PTR
 #include <memory>
@@ -58,10 +61,81 @@ namespace boost
 
     namespace detail
     {
+      // Holds an object of some type derived from Base, inside itself if
+      // it fits in the buffer, which is large enough for any standard
+      // library shared_ptr or weak_ptr, and on the heap otherwise.  Base
+      // must have a virtual destructor and a clone(void *buffer) which copies
+      // the object with clone_foreign_impl.
+      template<typename Base>
+      class foreign_impl_holder
+      {
+      public:
+        BOOST_STATIC_CONSTANT(std::size_t, buffer_size = 4 * sizeof(void*));
+
+        foreign_impl_holder(): _p(0)
+        {}
+        foreign_impl_holder(const foreign_impl_holder &other):
+          _p(other._p ? other._p->clone(&_buffer) : 0)
+        {}
+        template<typename Impl, typename Arg>
+        foreign_impl_holder(Impl *, const Arg &arg):
+          _p(create<Impl>(&_buffer, arg))
+        {}
+        ~foreign_impl_holder()
+        {
+          destroy();
+        }
+        foreign_impl_holder & operator=(const foreign_impl_holder &other)
+        {
+          if(&other == this) return *this;
+          foreign_impl_holder temp(other);
+          destroy();
+          _p = temp._p ? temp._p->clone(&_buffer) : 0;
+          return *this;
+        }
+        void swap(foreign_impl_holder &other)
+        {
+          foreign_impl_holder temp(other);
+          other = *this;
+          *this = temp;
+        }
+        Base * get() const {return _p;}
+
+        template<typename Impl, typename Arg>
+        static Base * create(void *buffer, const Arg &arg)
+        {
+          if(sizeof(Impl) <= buffer_size &&
+            boost::alignment_of<boost::detail::max_align>::value % boost::alignment_of<Impl>::value == 0)
+          {
+            return new(buffer) Impl(arg);
+          }
+          return new Impl(arg);
+        }
+      private:
+        void destroy()
+        {
+          if(_p == static_cast<void*>(&_buffer))
+            _p->~Base();
+          else
+            delete _p;
+          _p = 0;
+        }
+
+        Base *_p;
+        typename boost::aligned_storage<buffer_size,
+          boost::alignment_of<boost::detail::max_align>::value>::type _buffer;
+      };
+
+      template<typename Impl, typename Base>
+      Base * clone_foreign_impl(const Impl &impl, void *buffer)
+      {
+        return foreign_impl_holder<Base>::template create<Impl>(buffer, impl);
+      }
+
       struct foreign_shared_ptr_impl_base
       {
         virtual ~foreign_shared_ptr_impl_base() {}
-        virtual foreign_shared_ptr_impl_base * clone() const = 0;
+        virtual foreign_shared_ptr_impl_base * clone(void *buffer) const = 0;
       };
 
       template<typename FSP>
@@ -70,43 +144,31 @@ namespace boost
       public:
         foreign_shared_ptr_impl(const FSP &p): _p(p)
         {}
-        virtual foreign_shared_ptr_impl * clone() const
+        virtual foreign_shared_ptr_impl_base * clone(void *buffer) const
         {
-          return new foreign_shared_ptr_impl(*this);
+          return clone_foreign_impl<foreign_shared_ptr_impl, foreign_shared_ptr_impl_base>(*this, buffer);
         }
       private:
         FSP _p;
       };
 
+      // Locking a tracked std::weak_ptr during an invocation doesn't allocate,
+      // the locked pointer is held inside foreign_void_shared_ptr.
       class foreign_void_shared_ptr
       {
       public:
-        foreign_void_shared_ptr():
-          _p(0)
-        {}
-        foreign_void_shared_ptr(const foreign_void_shared_ptr &other):
-          _p(other._p->clone())
+        foreign_void_shared_ptr()
         {}
         template<typename FSP>
         explicit foreign_void_shared_ptr(const FSP &fsp):
-          _p(new foreign_shared_ptr_impl<FSP>(fsp))
+          _p(static_cast<foreign_shared_ptr_impl<FSP> *>(0), fsp)
         {}
-        ~foreign_void_shared_ptr()
-        {
-          delete _p;
-        }
-        foreign_void_shared_ptr & operator=(const foreign_void_shared_ptr &other)
-        {
-          if(&other == this) return *this;
-          foreign_void_shared_ptr(other).swap(*this);
-          return *this;
-        }
         void swap(foreign_void_shared_ptr &other)
         {
-          boost::core::invoke_swap(_p, other._p);
+          _p.swap(other._p);
         }
       private:
-        foreign_shared_ptr_impl_base *_p;
+        foreign_impl_holder<foreign_shared_ptr_impl_base> _p;
       };
 
       struct foreign_weak_ptr_impl_base
@@ -114,7 +176,7 @@ namespace boost
         virtual ~foreign_weak_ptr_impl_base() {}
         virtual foreign_void_shared_ptr lock() const = 0;
         virtual bool expired() const = 0;
-        virtual foreign_weak_ptr_impl_base * clone() const = 0;
+        virtual foreign_weak_ptr_impl_base * clone(void *buffer) const = 0;
       };
 
       template<typename FWP>
@@ -131,9 +193,9 @@ namespace boost
         {
           return _p.expired();
         }
-        virtual foreign_weak_ptr_impl * clone() const
+        virtual foreign_weak_ptr_impl_base * clone(void *buffer) const
         {
-          return new foreign_weak_ptr_impl(*this);
+          return clone_foreign_impl<foreign_weak_ptr_impl, foreign_weak_ptr_impl_base>(*this, buffer);
         }
       private:
         FWP _p;
@@ -144,33 +206,24 @@ namespace boost
       public:
         foreign_void_weak_ptr()
         {}
-        foreign_void_weak_ptr(const foreign_void_weak_ptr &other):
-          _p(other._p->clone())
-        {}
         template<typename FWP>
         explicit foreign_void_weak_ptr(const FWP &fwp):
-          _p(new foreign_weak_ptr_impl<FWP>(fwp))
+          _p(static_cast<foreign_weak_ptr_impl<FWP> *>(0), fwp)
         {}
-        foreign_void_weak_ptr & operator=(const foreign_void_weak_ptr &other)
-        {
-          if(&other == this) return *this;
-          foreign_void_weak_ptr(other).swap(*this);
-          return *this;
-        }
         void swap(foreign_void_weak_ptr &other)
         {
-          boost::core::invoke_swap(_p, other._p);
+          _p.swap(other._p);
         }
         foreign_void_shared_ptr lock() const
         {
-          return _p->lock();
+          return _p.get()->lock();
         }
         bool expired() const
         {
-          return _p->expired();
+          return _p.get()->expired();
         }
       private:
-        boost::scoped_ptr<foreign_weak_ptr_impl_base> _p;
+        foreign_impl_holder<foreign_weak_ptr_impl_base> _p;
       };
     } // namespace detail
 
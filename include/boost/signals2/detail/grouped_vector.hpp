@@ -0,0 +1,364 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_GROUPED_VECTOR_HPP
+#define BOOST_SIGNALS2_GROUPED_VECTOR_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      /* Iterator into a vector which holds a position rather than a pointer,
+      so it is not invalidated by inserting or erasing elsewhere in the
+      vector, it just sees whichever element has moved into its position. */
+      template<typename Value, typename Vector>
+      class vector_position_iterator: public boost::iterator_facade<vector_position_iterator<Value, Vector>,
+        Value, boost::forward_traversal_tag>
+      {
+      public:
+        typedef typename Vector::size_type size_type;
+
+        vector_position_iterator(): _vector(0), _position(0)
+        {}
+        vector_position_iterator(Vector *vector_in, size_type position):
+          _vector(vector_in), _position(position)
+        {}
+        // allows conversion from iterator to const_iterator
+        template<typename OtherValue, typename OtherVector>
+        vector_position_iterator(const vector_position_iterator<OtherValue, OtherVector> &other):
+          _vector(other._vector), _position(other._position)
+        {}
+        size_type position() const {return _position;}
+      private:
+        friend class boost::iterator_core_access;
+        template<typename OtherValue, typename OtherVector> friend class vector_position_iterator;
+
+        Value & dereference() const
+        {
+          return (*_vector)[_position];
+        }
+        void increment()
+        {
+          ++_position;
+        }
+        template<typename OtherValue, typename OtherVector>
+        bool equal(const vector_position_iterator<OtherValue, OtherVector> &other) const
+        {
+          return _position == other._position;
+        }
+
+        Vector *_vector;
+        size_type _position;
+      };
+
+      /* Moves the elements in [first, last) for which pred is false down to
+      start at position out, keeping their order, and returns the position
+      following the last one moved.  Used to remove any number of elements
+      in a single pass instead of erasing them one at a time. */
+      template<typename Vector, typename Predicate>
+      typename Vector::size_type compact_vector(Vector &vector_in, typename Vector::size_type first,
+        typename Vector::size_type last, typename Vector::size_type out, const Predicate &pred)
+      {
+        using std::swap;
+        for(; first != last; ++first)
+        {
+          if(pred(vector_in[first])) continue;
+          if(out != first) swap(vector_in[out], vector_in[first]);
+          ++out;
+        }
+        return out;
+      }
+
+      /* Drop-in replacement for grouped_list which keeps the slots in one
+      contiguous vector, so iterating through them during an invocation
+      touches memory linearly.  The groups are described by a sorted vector
+      holding the position of the first slot of each non-empty group.
+      Inserting or erasing a slot is linear in the number of slots, which
+      is cheap next to the copying already done by the signal whenever its
+      slot list is in use. */
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType>,
+        typename Vector = std::vector<ValueType, typename boost::allocator_rebind<Allocator, ValueType>::type> >
+      class grouped_vector
+      {
+      public:
+        typedef group_key_less<Group, GroupCompare> group_key_compare_type;
+        typedef typename group_key<Group>::type group_key_type;
+      private:
+        typedef Vector vector_type;
+        typedef typename vector_type::size_type size_type;
+        typedef std::pair<group_key_type, size_type> group_entry_type;
+        typedef std::vector<group_entry_type,
+          typename boost::allocator_rebind<Allocator, group_entry_type>::type> group_index_type;
+        typedef typename group_index_type::iterator group_iterator;
+
+        class group_entry_less
+        {
+        public:
+          group_entry_less(const group_key_compare_type &group_key_compare):
+            _group_key_compare(group_key_compare)
+          {}
+          bool operator()(const group_entry_type &entry, const group_key_type &key) const
+          {
+            return _group_key_compare(entry.first, key);
+          }
+          bool operator()(const group_key_type &key, const group_entry_type &entry) const
+          {
+            return _group_key_compare(key, entry.first);
+          }
+        private:
+          const group_key_compare_type &_group_key_compare;
+        };
+
+      public:
+        typedef vector_position_iterator<ValueType, vector_type> iterator;
+        typedef vector_position_iterator<const ValueType, const vector_type> const_iterator;
+
+        grouped_vector(const group_key_compare_type &group_key_compare,
+          const Allocator &allocator = Allocator()):
+          _vector(typename vector_type::allocator_type(allocator)),
+          _group_index(typename group_index_type::allocator_type(allocator)),
+          _group_key_compare(group_key_compare)
+        {}
+        // the group index holds positions rather than iterators, so unlike
+        // grouped_list's it needs no fixing up
+        grouped_vector(const grouped_vector &other): _vector(other._vector),
+          _group_index(other._group_index), _group_key_compare(other._group_key_compare)
+        {}
+        iterator begin()
+        {
+          return iterator(&_vector, 0);
+        }
+        iterator end()
+        {
+          return iterator(&_vector, _vector.size());
+        }
+        std::size_t size() const
+        {
+          return _vector.size();
+        }
+        iterator lower_bound(const group_key_type &key)
+        {
+          return iterator(&_vector, group_begin(group_lower_bound(key)));
+        }
+        iterator upper_bound(const group_key_type &key)
+        {
+          return iterator(&_vector, group_begin(group_upper_bound(key)));
+        }
+        void push_front(const group_key_type &key, const ValueType &value)
+        {
+          group_iterator group_it;
+          if(key.first == front_ungrouped_slots)
+          {// optimization
+            group_it = _group_index.begin();
+          }else
+          {
+            group_it = group_lower_bound(key);
+          }
+          const size_type position = group_begin(group_it);
+          _vector.insert(_vector.begin() + position, value);
+          if(group_it == _group_index.end() || weakly_equivalent(group_it->first, key) == false)
+          {
+            group_it = _group_index.insert(group_it, group_entry_type(key, position));
+          }
+          for(++group_it; group_it != _group_index.end(); ++group_it)
+          {
+            ++group_it->second;
+          }
+        }
+        void push_back(const group_key_type &key, const ValueType &value)
+        {
+          group_iterator group_it;
+          if(key.first == back_ungrouped_slots)
+          {// optimization
+            group_it = _group_index.end();
+          }else
+          {
+            group_it = group_upper_bound(key);
+          }
+          const size_type position = group_begin(group_it);
+          _vector.insert(_vector.begin() + position, value);
+          const bool new_group = group_it == _group_index.begin() ||
+            weakly_equivalent((group_it - 1)->first, key) == false;
+          group_iterator it;
+          for(it = group_it; it != _group_index.end(); ++it)
+          {
+            ++it->second;
+          }
+          if(new_group)
+          {
+            _group_index.insert(group_it, group_entry_type(key, position));
+          }
+        }
+        void erase(const group_key_type &key)
+        {
+          group_iterator group_it = group_lower_bound(key);
+          if(group_it == _group_index.end() || weakly_equivalent(group_it->first, key) == false)
+          {
+            return;
+          }
+          const size_type first = group_it->second;
+          const size_type count = group_begin(group_it + 1) - first;
+          _vector.erase(_vector.begin() + first, _vector.begin() + first + count);
+          group_it = _group_index.erase(group_it);
+          for(; group_it != _group_index.end(); ++group_it)
+          {
+            group_it->second -= count;
+          }
+        }
+        iterator erase(const group_key_type &key, const iterator &it)
+        {
+          BOOST_ASSERT(it != end());
+          group_iterator group_it = group_lower_bound(key);
+          BOOST_ASSERT(group_it != _group_index.end());
+          BOOST_ASSERT(weakly_equivalent(group_it->first, key));
+          const size_type position = it.position();
+          _vector.erase(_vector.begin() + position);
+          group_iterator next_group_it;
+          for(next_group_it = group_it + 1; next_group_it != _group_index.end(); ++next_group_it)
+          {
+            --next_group_it->second;
+          }
+          // erase group if it is now empty
+          if(group_begin(group_it + 1) == group_it->second)
+          {
+            _group_index.erase(group_it);
+          }
+          return iterator(&_vector, position);
+        }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          size_type out = 0;
+          group_iterator out_group_it = _group_index.begin();
+          group_iterator group_it;
+          for(group_it = _group_index.begin(); group_it != _group_index.end(); ++group_it)
+          {
+            const size_type group_out = out;
+            out = compact_vector(_vector, group_it->second, group_begin(group_it + 1), out, pred);
+            // keep the group only if some of its slots remain
+            if(out != group_out)
+            {
+              *out_group_it = group_entry_type(group_it->first, group_out);
+              ++out_group_it;
+            }
+          }
+          _vector.erase(_vector.begin() + out, _vector.end());
+          _group_index.erase(out_group_it, _group_index.end());
+        }
+        void clear()
+        {
+          _vector.clear();
+          _group_index.clear();
+        }
+      private:
+        /* Suppress default assignment operator, like grouped_list. */
+        grouped_vector& operator=(const grouped_vector &other);
+
+        bool weakly_equivalent(const group_key_type &arg1, const group_key_type &arg2) const
+        {
+          if(_group_key_compare(arg1, arg2)) return false;
+          if(_group_key_compare(arg2, arg1)) return false;
+          return true;
+        }
+        group_iterator group_lower_bound(const group_key_type &key)
+        {
+          return std::lower_bound(_group_index.begin(), _group_index.end(), key,
+            group_entry_less(_group_key_compare));
+        }
+        group_iterator group_upper_bound(const group_key_type &key)
+        {
+          return std::upper_bound(_group_index.begin(), _group_index.end(), key,
+            group_entry_less(_group_key_compare));
+        }
+        // position of the first slot in a group, or the end if there is no such group
+        size_type group_begin(const group_iterator &group_it) const
+        {
+          if(group_it == _group_index.end()) return _vector.size();
+          return group_it->second;
+        }
+
+        vector_type _vector;
+        group_index_type _group_index;
+        group_key_compare_type _group_key_compare;
+      };
+      /* Without groups there is no index, slots are only ever inserted at
+      either end of the vector. */
+      template<typename GroupCompare, typename ValueType, typename Allocator, typename Vector>
+      class grouped_vector<no_groups, GroupCompare, ValueType, Allocator, Vector>
+      {
+      public:
+        typedef group_key_less<no_groups, GroupCompare> group_key_compare_type;
+        typedef group_key<no_groups>::type group_key_type;
+      private:
+        typedef Vector vector_type;
+      public:
+        typedef vector_position_iterator<ValueType, vector_type> iterator;
+        typedef vector_position_iterator<const ValueType, const vector_type> const_iterator;
+
+        grouped_vector(const group_key_compare_type &, const Allocator &allocator = Allocator()):
+          _vector(typename vector_type::allocator_type(allocator))
+        {}
+        grouped_vector(const grouped_vector &other): _vector(other._vector)
+        {}
+        iterator begin()
+        {
+          return iterator(&_vector, 0);
+        }
+        iterator end()
+        {
+          return iterator(&_vector, _vector.size());
+        }
+        std::size_t size() const
+        {
+          return _vector.size();
+        }
+        void push_front(const group_key_type &, const ValueType &value)
+        {
+          _vector.insert(_vector.begin(), value);
+        }
+        void push_back(const group_key_type &, const ValueType &value)
+        {
+          _vector.push_back(value);
+        }
+        iterator erase(const group_key_type &, const iterator &it)
+        {
+          BOOST_ASSERT(it != end());
+          _vector.erase(_vector.begin() + it.position());
+          return it;
+        }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          _vector.erase(_vector.begin() + compact_vector(_vector, 0, _vector.size(), 0, pred), _vector.end());
+        }
+        void clear()
+        {
+          _vector.clear();
+        }
+      private:
+        /* Suppress default assignment operator, like grouped_list. */
+        grouped_vector& operator=(const grouped_vector &other);
+
+        vector_type _vector;
+      };
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_GROUPED_VECTOR_HPP
@@ -0,0 +1,87 @@
+/*
+  A shared_ptr which starts out null and is set at most once, possibly
+  concurrently with being read.  Used by signals to put off creating their
+  internals until they are first needed.
+*/
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_DETAIL_LAZY_SHARED_PTR_HPP
+#define BOOST_SIGNALS2_DETAIL_LAZY_SHARED_PTR_HPP
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/atomic.hpp>
+
+namespace boost
+{
+  namespace signals2
+  {
+    namespace detail
+    {
+      // The shared_ptr is kept on the heap behind an atomic pointer, so an
+      // unset lazy_shared_ptr is a single null pointer and reading it is a
+      // single load.  Threads racing to set it each create a value, and all
+      // but the first to publish theirs throw it away.  Only reset() and
+      // swap() must be serialized with every other use.
+      template<typename T>
+      class lazy_shared_ptr: public noncopyable
+      {
+      public:
+        lazy_shared_ptr(): _published(0)
+        {}
+        // set, unless value is null
+        explicit lazy_shared_ptr(const shared_ptr<T> &value):
+          _published(value ? new shared_ptr<T>(value) : 0)
+        {}
+        ~lazy_shared_ptr()
+        {
+          delete _published.load(memory_order_relaxed);
+        }
+        // null until set.  Wait-free.
+        T * get() const
+        {
+          const shared_ptr<T> *published = _published.load(memory_order_acquire);
+          return published ? published->get() : 0;
+        }
+        shared_ptr<T> load() const
+        {
+          const shared_ptr<T> *published = _published.load(memory_order_acquire);
+          return published ? *published : shared_ptr<T>();
+        }
+        // the value, after setting it to create() if it is unset
+        const shared_ptr<T> & get_or_create(shared_ptr<T> (*create)()) const
+        {
+          shared_ptr<T> *published = _published.load(memory_order_acquire);
+          if(published) return *published;
+          shared_ptr<T> *created = new shared_ptr<T>(create());
+          if(_published.compare_exchange_strong(published, created,
+            memory_order_acq_rel, memory_order_acquire))
+          {
+            return *created;
+          }
+          delete created;
+          return *published;
+        }
+        void reset()
+        {
+          delete _published.exchange(0, memory_order_relaxed);
+        }
+        void swap(lazy_shared_ptr &other)
+        {
+          shared_ptr<T> *published = _published.load(memory_order_relaxed);
+          _published.store(other._published.load(memory_order_relaxed), memory_order_relaxed);
+          other._published.store(published, memory_order_relaxed);
+        }
+      private:
+        mutable atomic<shared_ptr<T> *> _published;
+      };
+    } // namespace detail
+  } // namespace signals2
+} // namespace boost
+
+#endif // BOOST_SIGNALS2_DETAIL_LAZY_SHARED_PTR_HPP
@@ -0,0 +1,481 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_PERSISTENT_VECTOR_HPP
+#define BOOST_SIGNALS2_PERSISTENT_VECTOR_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/mpl/bool.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      /* Iterator into a persistent_vector.  Like vector_position_iterator it
+      is identified by its position, so it survives insertions and erasures
+      elsewhere by seeing whichever slot moves into its position.  It also
+      keeps the chunk and offset of that position, which it looks up again
+      if the vector has been modified since. */
+      template<typename List, typename Value>
+      class persistent_vector_iterator: public boost::iterator_facade<persistent_vector_iterator<List, Value>,
+        Value, boost::forward_traversal_tag>
+      {
+      public:
+        typedef std::size_t size_type;
+
+        persistent_vector_iterator(): _list(0), _position(0), _chunk(0), _offset(0), _generation(0)
+        {}
+        persistent_vector_iterator(List *list_in, size_type position, size_type chunk, size_type offset):
+          _list(list_in), _position(position), _chunk(chunk), _offset(offset),
+          _generation(list_in->_generation)
+        {}
+        // allows conversion from iterator to const_iterator
+        template<typename OtherList, typename OtherValue>
+        persistent_vector_iterator(const persistent_vector_iterator<OtherList, OtherValue> &other):
+          _list(other._list), _position(other._position), _chunk(other._chunk), _offset(other._offset),
+          _generation(other._generation)
+        {}
+        size_type position() const {return _position;}
+      private:
+        friend class boost::iterator_core_access;
+        template<typename OtherList, typename OtherValue> friend class persistent_vector_iterator;
+        template<typename Group, typename GroupCompare, typename ValueType, typename Allocator>
+          friend class persistent_vector;
+
+        Value & dereference() const
+        {
+          seek();
+          return (*(*_list->_spine)[_chunk])[_offset];
+        }
+        void increment()
+        {
+          ++_position;
+          // a stale chunk and offset are looked up on the next dereference
+          if(_generation != _list->_generation) return;
+          if(++_offset == (*_list->_spine)[_chunk]->size())
+          {
+            ++_chunk;
+            _offset = 0;
+          }
+        }
+        template<typename OtherList, typename OtherValue>
+        bool equal(const persistent_vector_iterator<OtherList, OtherValue> &other) const
+        {
+          return _position == other._position;
+        }
+        void seek() const
+        {
+          if(_generation == _list->_generation) return;
+          _list->locate(_position, _chunk, _offset);
+          _generation = _list->_generation;
+        }
+
+        List *_list;
+        size_type _position;
+        mutable size_type _chunk;
+        mutable size_type _offset;
+        mutable std::size_t _generation;
+      };
+
+      /* Slot list whose copies share their storage.  The slots are kept in
+      chunks of at most chunk_capacity slots, which are shared by every copy
+      of the list until one of the copies modifies them, so copying the list
+      while an invocation is using it costs a single reference count.  The
+      first modification of a copy then duplicates the array of chunk
+      pointers and the chunk it changes, which is linear in the number of
+      chunks rather than the number of slots.  As in ungrouped_vector, there
+      is no group index: a group is found by a binary search over the group
+      keys of the slots themselves, so ValueType must be a pointer to an
+      object with a group_key() method. */
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class persistent_vector
+      {
+        template<typename List, typename Value> friend class persistent_vector_iterator;
+      public:
+        typedef group_key_less<Group, GroupCompare> group_key_compare_type;
+        typedef typename group_key<Group>::type group_key_type;
+        // the most slots a chunk holds before it is split in two
+        BOOST_STATIC_CONSTANT(std::size_t, chunk_capacity = 64);
+      private:
+        typedef std::size_t size_type;
+        typedef std::vector<ValueType, typename boost::allocator_rebind<Allocator, ValueType>::type> chunk_type;
+        typedef shared_ptr<chunk_type> chunk_pointer;
+        typedef std::vector<chunk_pointer,
+          typename boost::allocator_rebind<Allocator, chunk_pointer>::type> spine_type;
+
+        class value_less
+        {
+        public:
+          value_less(const group_key_compare_type &group_key_compare):
+            _group_key_compare(group_key_compare)
+          {}
+          bool operator()(const ValueType &value, const group_key_type &key) const
+          {
+            return _group_key_compare(value->group_key(), key);
+          }
+          bool operator()(const group_key_type &key, const ValueType &value) const
+          {
+            return _group_key_compare(key, value->group_key());
+          }
+        private:
+          const group_key_compare_type &_group_key_compare;
+        };
+        class in_group
+        {
+        public:
+          in_group(const group_key_compare_type &group_key_compare, const group_key_type &key):
+            _group_key_compare(group_key_compare), _key(key)
+          {}
+          bool operator()(const ValueType &value) const
+          {
+            return _group_key_compare(value->group_key(), _key) == false &&
+              _group_key_compare(_key, value->group_key()) == false;
+          }
+        private:
+          const group_key_compare_type &_group_key_compare;
+          const group_key_type &_key;
+        };
+      public:
+        typedef persistent_vector_iterator<persistent_vector, ValueType> iterator;
+        typedef persistent_vector_iterator<const persistent_vector, const ValueType> const_iterator;
+
+        persistent_vector(const group_key_compare_type &group_key_compare,
+          const Allocator &allocator = Allocator()):
+          _allocator(allocator),
+          _spine(boost::allocate_shared<spine_type>(allocator, typename spine_type::allocator_type(allocator))),
+          _size(0),
+          _generation(0),
+          _group_key_compare(group_key_compare)
+        {}
+        iterator begin()
+        {
+          return iterator(this, 0, 0, 0);
+        }
+        iterator end()
+        {
+          return iterator(this, _size, _spine->size(), 0);
+        }
+        // the iterator at the same position as an iterator into another copy of the list
+        iterator rebase(const iterator &other)
+        {
+          BOOST_ASSERT(other.position() <= _size);
+          size_type chunk, offset;
+          locate(other.position(), chunk, offset);
+          return iterator(this, other.position(), chunk, offset);
+        }
+        std::size_t size() const
+        {
+          return _size;
+        }
+        iterator lower_bound(const group_key_type &key)
+        {
+          size_type chunk, offset;
+          find_lower_bound(key, chunk, offset);
+          return make_iterator(chunk, offset);
+        }
+        iterator upper_bound(const group_key_type &key)
+        {
+          size_type chunk, offset;
+          find_upper_bound(key, chunk, offset);
+          return make_iterator(chunk, offset);
+        }
+        void push_front(const group_key_type &key, const ValueType &value)
+        {
+          size_type chunk = 0, offset = 0;
+          if(is_front_ungrouped(key) == false) find_lower_bound(key, chunk, offset);
+          insert(chunk, offset, value);
+        }
+        void push_back(const group_key_type &key, const ValueType &value)
+        {
+          size_type chunk = _spine->size(), offset = 0;
+          if(is_back_ungrouped(key) == false) find_upper_bound(key, chunk, offset);
+          insert(chunk, offset, value);
+        }
+        void erase(const group_key_type &key)
+        {
+          remove_if(in_group(_group_key_compare, key));
+        }
+        iterator erase(const group_key_type &, const iterator &it)
+        {
+          BOOST_ASSERT(it != end());
+          size_type chunk, offset;
+          locate(it, chunk, offset);
+          make_spine_unique();
+          if((*_spine)[chunk]->size() == 1)
+          {
+            _spine->erase(_spine->begin() + chunk);
+          }else
+          {
+            chunk_type &values = unique_chunk(chunk);
+            values.erase(values.begin() + offset);
+            merge_with_next(chunk);
+            if(offset == (*_spine)[chunk]->size())
+            {
+              ++chunk;
+              offset = 0;
+            }
+          }
+          --_size;
+          ++_generation;
+          return iterator(this, it.position(), chunk, offset);
+        }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          shared_ptr<spine_type> spine =
+            boost::allocate_shared<spine_type>(_allocator, typename spine_type::allocator_type(_allocator));
+          spine->reserve(_spine->size());
+          // chunks which lose no slots are shared with the old list, the
+          // slots left in the others are packed into new chunks
+          chunk_pointer packed;
+          std::vector<char> removed;
+          size_type size = 0;
+          for(size_type i = 0; i < _spine->size(); ++i)
+          {
+            const chunk_type &values = *(*_spine)[i];
+            removed.assign(values.size(), false);
+            size_type kept = 0;
+            for(size_type j = 0; j < values.size(); ++j)
+            {
+              removed[j] = pred(values[j]);
+              if(removed[j] == false) ++kept;
+            }
+            size += kept;
+            if(kept == values.size())
+            {
+              if(packed) spine->push_back(packed);
+              packed.reset();
+              spine->push_back((*_spine)[i]);
+              continue;
+            }
+            for(size_type j = 0; j < values.size(); ++j)
+            {
+              if(removed[j]) continue;
+              if(!packed) packed = new_chunk();
+              packed->push_back(values[j]);
+              if(packed->size() == chunk_capacity)
+              {
+                spine->push_back(packed);
+                packed.reset();
+              }
+            }
+          }
+          if(packed) spine->push_back(packed);
+          _spine = spine;
+          _size = size;
+          ++_generation;
+        }
+        void clear()
+        {
+          _spine = boost::allocate_shared<spine_type>(_allocator, typename spine_type::allocator_type(_allocator));
+          _size = 0;
+          ++_generation;
+        }
+      private:
+        /* Suppress default assignment operator, like grouped_list. */
+        persistent_vector& operator=(const persistent_vector &other);
+
+        static bool is_front_ungrouped(const no_group_key &) {return true;}
+        static bool is_back_ungrouped(const no_group_key &) {return true;}
+        template<typename Key>
+        static bool is_front_ungrouped(const Key &key) {return key.first == front_ungrouped_slots;}
+        template<typename Key>
+        static bool is_back_ungrouped(const Key &key) {return key.first == back_ungrouped_slots;}
+
+        chunk_pointer new_chunk() const
+        {
+          chunk_pointer chunk = boost::allocate_shared<chunk_type>(_allocator,
+            typename chunk_type::allocator_type(_allocator));
+          chunk->reserve(chunk_capacity);
+          return chunk;
+        }
+        // the spine and chunks of a list which shares them are never modified
+        void make_spine_unique()
+        {
+          if(_spine.unique() == false)
+            _spine = boost::allocate_shared<spine_type>(_allocator, *_spine);
+        }
+        chunk_type & unique_chunk(size_type chunk)
+        {
+          BOOST_ASSERT(_spine.unique());
+          chunk_pointer &values = (*_spine)[chunk];
+          if(values.unique() == false)
+          {
+            chunk_pointer copy = new_chunk();
+            copy->assign(values->begin(), values->end());
+            values = copy;
+          }
+          return *values;
+        }
+        void insert(size_type chunk, size_type offset, const ValueType &value)
+        {
+          make_spine_unique();
+          const bool at_end = chunk == _spine->size();
+          if(at_end && chunk > 0)
+          {
+            --chunk;
+            offset = (*_spine)[chunk]->size();
+          }
+          // a full chunk at either end of the list gets a new neighbour
+          // rather than being split
+          if(_spine->empty() ||
+            ((*_spine)[chunk]->size() >= chunk_capacity &&
+              ((at_end && chunk + 1 == _spine->size()) || (chunk == 0 && offset == 0))))
+          {
+            chunk_pointer values = new_chunk();
+            values->push_back(value);
+            const size_type position = (_spine->empty() || offset == 0) ? chunk : chunk + 1;
+            _spine->insert(_spine->begin() + position, values);
+          }else
+          {
+            chunk_type &values = unique_chunk(chunk);
+            values.insert(values.begin() + offset, value);
+            if(values.size() > chunk_capacity) split(chunk);
+          }
+          ++_size;
+          ++_generation;
+        }
+        // moves the second half of an overfull chunk into a new chunk after it
+        void split(size_type chunk)
+        {
+          chunk_type &values = *(*_spine)[chunk];
+          const size_type half = values.size() / 2;
+          chunk_pointer second = new_chunk();
+          second->assign(values.begin() + half, values.end());
+          _spine->insert(_spine->begin() + chunk + 1, second);
+          values.erase(values.begin() + half, values.end());
+        }
+        // keeps erasures from leaving many small chunks behind
+        void merge_with_next(size_type chunk)
+        {
+          if(chunk + 1 >= _spine->size()) return;
+          chunk_type &values = *(*_spine)[chunk];
+          const chunk_type &next = *(*_spine)[chunk + 1];
+          if(values.size() + next.size() > chunk_capacity / 2) return;
+          values.insert(values.end(), next.begin(), next.end());
+          _spine->erase(_spine->begin() + chunk + 1);
+        }
+        // finds the chunk and offset of a position
+        void locate(size_type position, size_type &chunk, size_type &offset) const
+        {
+          for(chunk = 0; chunk < _spine->size(); ++chunk)
+          {
+            const size_type chunk_size = (*_spine)[chunk]->size();
+            if(position < chunk_size) break;
+            position -= chunk_size;
+          }
+          offset = position;
+        }
+        void locate(const iterator &it, size_type &chunk, size_type &offset) const
+        {
+          if(it._generation == _generation)
+          {
+            chunk = it._chunk;
+            offset = it._offset;
+          }else
+          {
+            locate(it.position(), chunk, offset);
+          }
+        }
+        iterator make_iterator(size_type chunk, size_type offset)
+        {
+          size_type position = offset;
+          for(size_type i = 0; i < chunk; ++i)
+            position += (*_spine)[i]->size();
+          if(chunk < _spine->size() && offset == (*_spine)[chunk]->size())
+          {
+            ++chunk;
+            offset = 0;
+          }
+          return iterator(this, position, chunk, offset);
+        }
+        // the chunks are searched by their last slot, then the slots of the chunk found
+        void find_lower_bound(const group_key_type &key, size_type &chunk, size_type &offset) const
+        {
+          size_type first = 0, count = _spine->size();
+          while(count > 0)
+          {
+            const size_type step = count / 2;
+            if(_group_key_compare((*_spine)[first + step]->back()->group_key(), key))
+            {
+              first += step + 1;
+              count -= step + 1;
+            }else
+            {
+              count = step;
+            }
+          }
+          chunk = first;
+          if(chunk == _spine->size())
+          {
+            offset = 0;
+            return;
+          }
+          const chunk_type &values = *(*_spine)[chunk];
+          offset = std::lower_bound(values.begin(), values.end(), key, value_less(_group_key_compare)) -
+            values.begin();
+        }
+        void find_upper_bound(const group_key_type &key, size_type &chunk, size_type &offset) const
+        {
+          size_type first = 0, count = _spine->size();
+          while(count > 0)
+          {
+            const size_type step = count / 2;
+            if(_group_key_compare(key, (*_spine)[first + step]->back()->group_key()) == false)
+            {
+              first += step + 1;
+              count -= step + 1;
+            }else
+            {
+              count = step;
+            }
+          }
+          chunk = first;
+          if(chunk == _spine->size())
+          {
+            offset = 0;
+            return;
+          }
+          const chunk_type &values = *(*_spine)[chunk];
+          offset = std::upper_bound(values.begin(), values.end(), key, value_less(_group_key_compare)) -
+            values.begin();
+        }
+
+        Allocator _allocator;
+        shared_ptr<spine_type> _spine;
+        size_type _size;
+        // changed by every modification, so iterators know to look up their position again
+        std::size_t _generation;
+        group_key_compare_type _group_key_compare;
+      };
+
+      // whether copies of a slot list share their storage, which makes
+      // copying the list much cheaper than a pass over its slots
+      template<typename List>
+      class shares_storage: public mpl::false_
+      {};
+      template<typename Group, typename GroupCompare, typename ValueType, typename Allocator>
+      class shares_storage<persistent_vector<Group, GroupCompare, ValueType, Allocator> >: public mpl::true_
+      {};
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_PERSISTENT_VECTOR_HPP
@@ -0,0 +1,88 @@
+/*
+  A shared_ptr which may be read concurrently with being replaced, where
+  the read side never blocks.  Used by signals whose Mutex is an rcu_mutex
+  to let invocations obtain the current slot list without locking.
+*/
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_DETAIL_RCU_SHARED_PTR_HPP
+#define BOOST_SIGNALS2_DETAIL_RCU_SHARED_PTR_HPP
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/atomic.hpp>
+#include <boost/smart_ptr/detail/yield_k.hpp>
+
+namespace boost
+{
+  namespace signals2
+  {
+    namespace detail
+    {
+      // Readers announce themselves in one of two counters, selected by the
+      // current epoch, only for as long as it takes to copy the published
+      // shared_ptr.  A writer swaps in a new shared_ptr and then waits for
+      // both counters to drain once before deleting the old one, which is
+      // the classic two-phase grace period of user-space RCU.  Writers must
+      // be serialized by the caller.
+      template<typename T>
+      class rcu_shared_ptr: public noncopyable
+      {
+      public:
+        rcu_shared_ptr(): _published(0), _epoch(0)
+        {
+          _readers[0].store(0, memory_order_relaxed);
+          _readers[1].store(0, memory_order_relaxed);
+        }
+        ~rcu_shared_ptr()
+        {
+          delete _published.load(memory_order_relaxed);
+        }
+        // wait-free
+        shared_ptr<T> load() const
+        {
+          const unsigned epoch = _epoch.load(memory_order_seq_cst) & 1u;
+          _readers[epoch].fetch_add(1, memory_order_seq_cst);
+          shared_ptr<T> result;
+          const shared_ptr<T> *published = _published.load(memory_order_seq_cst);
+          if(published) result = *published;
+          _readers[epoch].fetch_sub(1, memory_order_release);
+          return result;
+        }
+        void store(const shared_ptr<T> &value)
+        {
+          shared_ptr<T> *old = _published.exchange(new shared_ptr<T>(value), memory_order_seq_cst);
+          if(old == 0) return;
+          synchronize();
+          delete old;
+        }
+      private:
+        // wait until no reader can still be copying a shared_ptr which was
+        // published before the call
+        void synchronize()
+        {
+          for(unsigned phase = 0; phase < 2; ++phase)
+          {
+            const unsigned old_epoch = _epoch.load(memory_order_relaxed);
+            _epoch.store(old_epoch + 1, memory_order_seq_cst);
+            for(unsigned k = 0; _readers[old_epoch & 1u].load(memory_order_seq_cst) != 0; ++k)
+            {
+              boost::detail::yield(k);
+            }
+          }
+        }
+
+        atomic<shared_ptr<T> *> _published;
+        atomic<unsigned> _epoch;
+        mutable atomic<unsigned> _readers[2];
+      };
+    } // namespace detail
+  } // namespace signals2
+} // namespace boost
+
+#endif // BOOST_SIGNALS2_DETAIL_RCU_SHARED_PTR_HPP
@@ -19,10 +19,10 @@
 #define BOOST_SIGNALS2_NUM_ARGS 1
 #endif
 
-// R, T1, T2, ..., TN, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex
+// R, T1, T2, ..., TN, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION \
   BOOST_SIGNALS2_SIGNATURE_TEMPLATE_INSTANTIATION(BOOST_SIGNALS2_NUM_ARGS), \
-  Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex
+  Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection
 
 namespace boost
 {
@@ -140,9 +140,14 @@ namespace boost
         typedef variadic_slot_invoker<nonvoid_slot_result_type, Args...> slot_invoker;
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
         typedef slot_call_iterator_cache<nonvoid_slot_result_type, slot_invoker> slot_call_iterator_cache_type;
+        typedef batch_call_cache<nonvoid_slot_result_type, slot_invoker> batch_call_cache_type;
         typedef typename group_key<Group>::type group_key_type;
         typedef shared_ptr<connection_body<group_key_type, slot_type, Mutex> > connection_body_type;
-        typedef grouped_list<Group, GroupCompare, connection_body_type> connection_list_type;
+        typedef typename SlotStorage::template apply<Group, GroupCompare, connection_body_type,
+          typename boost::allocator_rebind<Allocator, connection_body_type>::type>::type connection_list_type;
+        typedef batch_slots<connection_body_type> batch_slots_type;
+        typedef slot_index<connection_body_type> slot_index_type;
+        typedef batch_call_iterator_t<slot_invoker, typename batch_slots_type::const_iterator> batch_call_iterator;
         typedef BOOST_SIGNALS2_BOUND_EXTENDED_SLOT_FUNCTION_N(BOOST_SIGNALS2_NUM_ARGS)<extended_slot_function_type>
           bound_extended_slot_function_type;
       public:
@@ -150,17 +155,22 @@ namespace boost
         typedef typename result_type_wrapper<typename combiner_type::result_type>::type result_type;
         typedef Group group_type;
         typedef GroupCompare group_compare_type;
+        typedef Allocator allocator_type;
         typedef typename detail::slot_call_iterator_t<slot_invoker,
           typename connection_list_type::iterator, connection_body<group_key_type, slot_type, Mutex> > slot_call_iterator;
         typedef detail::BOOST_SIGNALS2_WEAK_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)
           <BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION> weak_signal_type;
 
         BOOST_SIGNALS2_SIGNAL_IMPL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)(const combiner_type &combiner_arg,
-          const group_compare_type &group_compare):
-          _shared_state(boost::make_shared<invocation_state>(connection_list_type(group_compare), combiner_arg)),
+          const group_compare_type &group_compare, const allocator_type &alloc):
+          _allocator(alloc),
+          _shared_state(make_invocation_state(alloc,
+            connection_list_type(group_compare, alloc), combiner_arg)),
           _garbage_collector_it(_shared_state->connection_bodies().end()),
-          _mutex(new mutex_type())
-        {}
+          _mutex(boost::allocate_shared<counted_mutex>(alloc))
+        {
+          nolock_publish_state(lock_free_emission());
+        }
         // connect slot
         connection connect(const slot_type &slot, connect_position position = at_back)
         {
@@ -173,6 +183,21 @@ namespace boost
           garbage_collecting_lock<mutex_type> lock(*_mutex);
           return nolock_connect(lock, group, slot, position);
         }
+        connection_handle connect_handle(const slot_type &slot, connect_position position)
+        {
+          garbage_collecting_lock<mutex_type> lock(*_mutex);
+          connection_handle handle;
+          nolock_connect(lock, slot, position, &handle);
+          return handle;
+        }
+        connection_handle connect_handle(const group_type &group,
+          const slot_type &slot, connect_position position)
+        {
+          garbage_collecting_lock<mutex_type> lock(*_mutex);
+          connection_handle handle;
+          nolock_connect(lock, group, slot, position, &handle);
+          return handle;
+        }
         // connect extended slot
         connection connect_extended(const extended_slot_type &ext_slot, connect_position position = at_back)
         {
@@ -196,7 +221,7 @@ namespace boost
         // disconnect slot(s)
         void disconnect_all_slots()
         {
-          shared_ptr<invocation_state> local_state =
+          invocation_state_ptr local_state =
             get_readable_state();
           typename connection_list_type::iterator it;
           for(it = local_state->connection_bodies().begin();
@@ -207,7 +232,7 @@ namespace boost
         }
         void disconnect(const group_type &group)
         {
-          shared_ptr<invocation_state> local_state =
+          invocation_state_ptr local_state =
             get_readable_state();
           group_key_type group_key(grouped_slots, group);
           typename connection_list_type::iterator it;
@@ -225,79 +250,112 @@ namespace boost
           typedef mpl::bool_<(is_convertible<T, group_type>::value)> is_group;
           do_disconnect(unwrap_ref(slot), is_group());
         }
-        // emit signal
-        result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
+        void disconnect(const connection_handle &handle)
         {
-          shared_ptr<invocation_state> local_state;
-          typename connection_list_type::iterator it;
+          get_connection(handle).disconnect();
+        }
+        // lock-free, unless the slot has tracked objects which may have expired
+        bool connected(const connection_handle &handle) const
+        {
+          const slot_table *table = _mutex->counts.handles.load(memory_order_acquire);
+          if(table == 0) return false;
+          const slot_table::entry *entry = table->find(handle.index());
+          if(entry == 0) return false;
+          const slot_table::state_type state = entry->state.load(memory_order_acquire);
+          if(slot_table::entry::generation(state) != handle.generation() ||
+            (state & slot_table::connected_flag) == 0)
           {
-            garbage_collecting_lock<mutex_type> list_lock(*_mutex);
-            // only clean up if it is safe to do so
-            if(_shared_state.unique())
-              nolock_cleanup_connections(list_lock, false, 1);
-            /* Make a local copy of _shared_state while holding mutex, so we are
-            thread safe against the combiner or connection list getting modified
-            during invocation. */
-            local_state = _shared_state;
+            return false;
           }
-          slot_invoker invoker = slot_invoker(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
-          slot_call_iterator_cache_type cache(invoker);
-          invocation_janitor janitor(cache, *this, &local_state->connection_bodies());
-          return detail::combiner_invoker<typename combiner_type::result_type>()
-            (
-              local_state->combiner(),
-              slot_call_iterator(local_state->connection_bodies().begin(), local_state->connection_bodies().end(), cache),
-              slot_call_iterator(local_state->connection_bodies().end(), local_state->connection_bodies().end(), cache)
-            );
+          if((state & slot_table::tracked_flag) == 0) return true;
+          return get_connection(handle).connected();
         }
-        result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS)) const
+        connection get_connection(const connection_handle &handle) const
         {
-          shared_ptr<invocation_state> local_state;
-          typename connection_list_type::iterator it;
+          unique_lock<mutex_type> lock(*_mutex);
+          const slot_table *table = _mutex->counts.handles.load(memory_order_relaxed);
+          if(table == 0) return connection();
+          const slot_table::entry *entry = table->find(handle.index());
+          // the body of an entry in use is kept alive by the slot list
+          if(entry == 0 || entry->body == 0 ||
+            slot_table::entry::generation(entry->state.load(memory_order_relaxed)) != handle.generation())
           {
-            garbage_collecting_lock<mutex_type> list_lock(*_mutex);
-            // only clean up if it is safe to do so
-            if(_shared_state.unique())
-              nolock_cleanup_connections(list_lock, false, 1);
-            /* Make a local copy of _shared_state while holding mutex, so we are
-            thread safe against the combiner or connection list getting modified
-            during invocation. */
-            local_state = _shared_state;
+            return connection();
           }
+          return connection(entry->body->shared_from_this());
+        }
+        // emit signal
+        result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
+        {
+          return invoke(slot_invoker(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS)),
+            direct_void_emission());
+        }
+        result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS)) const
+        {
+          return invoke(slot_invoker(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS)),
+            direct_void_emission());
+        }
+        // invokes a signal which hasn't created its internals yet, so has no
+        // slots, using a default constructed combiner.  Only used for empty,
+        // trivially constructed combiners, which have no state to lose.
+        static result_type invoke_unconnected(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
+        {
           slot_invoker invoker = slot_invoker(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
           slot_call_iterator_cache_type cache(invoker);
-          invocation_janitor janitor(cache, *this, &local_state->connection_bodies());
+          combiner_type combiner = combiner_type();
+          // value initialized iterators delimit an empty range
+          const typename connection_list_type::iterator none = typename connection_list_type::iterator();
           return detail::combiner_invoker<typename combiner_type::result_type>()
             (
-              local_state->combiner(),
-              slot_call_iterator(local_state->connection_bodies().begin(), local_state->connection_bodies().end(), cache),
-              slot_call_iterator(local_state->connection_bodies().end(), local_state->connection_bodies().end(), cache)
+              combiner,
+              slot_call_iterator(none, none, cache),
+              slot_call_iterator(none, none, cache)
             );
         }
-        std::size_t num_slots() const
+        // emit the signal once for each set of arguments in [first, last),
+        // locking the slot list and the slots' tracked objects only once
+        template<typename InputIterator>
+        void emit_batch(InputIterator first, InputIterator last) const
         {
-          shared_ptr<invocation_state> local_state =
-            get_readable_state();
-          typename connection_list_type::iterator it;
-          std::size_t count = 0;
-          for(it = local_state->connection_bodies().begin();
-            it != local_state->connection_bodies().end(); ++it)
+          invocation_state_ptr local_state =
+            get_invocation_state(lock_free_emission());
+          batch_slots_type slots(local_state->connection_bodies().begin(), local_state->connection_bodies().end());
+          invocation_janitor<batch_slots_type> janitor(slots, *this, &local_state->connection_bodies());
+          for(; first != last; ++first)
           {
-            if((*it)->connected()) ++count;
+            typename std::iterator_traits<InputIterator>::reference args = *first;
+            emit_batch_element(*local_state, slots, args);
           }
-          return count;
         }
-        bool empty() const
+        template<typename InputIterator, typename OutputIterator>
+        OutputIterator emit_batch(InputIterator first, InputIterator last, OutputIterator results) const
         {
-          shared_ptr<invocation_state> local_state =
-            get_readable_state();
-          typename connection_list_type::iterator it;
-          for(it = local_state->connection_bodies().begin();
-            it != local_state->connection_bodies().end(); ++it)
+          invocation_state_ptr local_state =
+            get_invocation_state(lock_free_emission());
+          batch_slots_type slots(local_state->connection_bodies().begin(), local_state->connection_bodies().end());
+          invocation_janitor<batch_slots_type> janitor(slots, *this, &local_state->connection_bodies());
+          for(; first != last; ++first)
           {
-            if((*it)->connected()) return false;
+            typename std::iterator_traits<InputIterator>::reference args = *first;
+            *results++ = emit_batch_element(*local_state, slots, args);
           }
-          return true;
+          return results;
+        }
+        std::size_t num_slots() const
+        {
+          // only slots with tracked objects need checking for expiry,
+          // which disconnects them and so keeps the count up to date
+          if(_mutex->counts.tracked.load(memory_order_relaxed) != 0)
+            check_tracked_connections();
+          return _mutex->counts.connected.load(memory_order_relaxed);
+        }
+        bool empty() const
+        {
+          const std::size_t connected = _mutex->counts.connected.load(memory_order_relaxed);
+          if(connected == 0) return true;
+          if(connected > _mutex->counts.tracked.load(memory_order_relaxed)) return false;
+          check_tracked_connections();
+          return _mutex->counts.connected.load(memory_order_relaxed) == 0;
         }
         combiner_type combiner() const
         {
@@ -307,13 +365,155 @@ namespace boost
         void set_combiner(const combiner_type &combiner_arg)
         {
           unique_lock<mutex_type> lock(*_mutex);
-          if(_shared_state.unique())
+          if(unique_state(_shared_state))
             _shared_state->combiner() = combiner_arg;
           else
-            _shared_state = boost::make_shared<invocation_state>(*_shared_state, combiner_arg);
+            _shared_state = make_invocation_state(_allocator, *_shared_state, combiner_arg);
+          nolock_publish_state(lock_free_emission());
+        }
+        // removes disconnected slots from the slot list, checking at most
+        // budget of them, and returns how many were removed
+        std::size_t collect_garbage(std::size_t budget)
+        {
+          if(budget == 0) return 0;
+          garbage_collecting_lock<mutex_type> lock(*_mutex);
+          const std::size_t size = _shared_state->connection_bodies().size();
+          if(unique_state(_shared_state) == false)
+          {
+            // the slot list is being read, so collect from a copy of it,
+            // which takes a pass over the whole list anyway
+            if(size == _mutex->counts.connected.load(memory_order_relaxed)) return 0;
+            _shared_state = make_invocation_state(_allocator,
+              *_shared_state, _shared_state->connection_bodies());
+            nolock_cleanup_all_connections(lock, true);
+          }else if(budget >= size)
+          {
+            nolock_cleanup_all_connections(lock, true);
+          }else
+          {
+            nolock_cleanup_connections(lock, true, static_cast<unsigned>(budget));
+          }
+          nolock_publish_state(lock_free_emission());
+          return size - _shared_state->connection_bodies().size();
+        }
+        // A connection made through a connection_batch.  It counts as
+        // connected from the start, but only goes into the slot list, and
+        // gets invoked, once the batch is committed.
+        class pending_connection
+        {
+        public:
+          pending_connection(const connection_body_type &body_arg, connect_position position_arg):
+            body(body_arg), position(position_arg)
+          {}
+          connection_body_type body;
+          connect_position position;
+        };
+        typedef std::vector<pending_connection> pending_connection_list;
+
+        connection add_pending_connection(pending_connection_list &pending,
+          const slot_type &slot, connect_position position)
+        {
+          connection_body_type body = new_connection_body(slot);
+          body->set_group_key(detail::group_key<Group>::ungrouped(
+            position == at_back ? back_ungrouped_slots : front_ungrouped_slots));
+          return add_pending_body(pending, body, position);
+        }
+        connection add_pending_connection(pending_connection_list &pending,
+          const group_type &group, const slot_type &slot, connect_position position)
+        {
+          connection_body_type body = new_connection_body(slot);
+          body->set_group_key(group_key_type(grouped_slots, group));
+          return add_pending_body(pending, body, position);
+        }
+        /* Disconnects a batch's disconnections and puts its pending connections
+        in the slot list, taking the signal's mutex once and copying the slot
+        list at most once.  Connections to other signals are disconnected after
+        the mutex is released, with one lock of each of their signals. */
+        void commit_batch(pending_connection_list &pending, const std::vector<connection> &disconnections)
+        {
+          std::vector<shared_ptr<connection_body_base> > other_bodies;
+          {
+            garbage_collecting_lock<mutex_type> lock(*_mutex);
+            bool disconnected = false;
+            for(std::size_t i = 0; i < disconnections.size(); ++i)
+            {
+              const shared_ptr<connection_body_base> body(connection_access::body(disconnections[i]));
+              if(!body) continue;
+              if(body->counts() == &_mutex->counts)
+              {
+                body->nolock_disconnect(lock);
+                disconnected = true;
+              }else
+              {
+                other_bodies.push_back(body);
+              }
+            }
+            if(pending.empty() == false || disconnected)
+            {
+              if(unique_state(_shared_state) == false)
+              {
+                // invocations are reading the slot list, so it gets copied
+                // once, leaving out the slots just disconnected
+                _shared_state = make_invocation_state(_allocator,
+                  *_shared_state, _shared_state->connection_bodies());
+                nolock_cleanup_all_connections(lock, true);
+              }else if(defer_collection::value)
+              {
+                nolock_force_unique_connection_list(lock);
+              }else
+              {
+                // collects as much as connecting the slots one at a time
+                // would have, or everything once the batch has disconnected some
+                const std::size_t budget = 2 * pending.size();
+                if(disconnected || budget >= _shared_state->connection_bodies().size())
+                  nolock_cleanup_all_connections(lock, true);
+                else
+                  nolock_cleanup_connections(lock, true, static_cast<unsigned>(budget));
+              }
+              for(std::size_t i = 0; i < pending.size(); ++i)
+              {
+                const connection_body_type &body = pending[i].body;
+                // skips connections disconnected before the commit
+                if(body->nolock_nograb_connected() == false) continue;
+                if(pending[i].position == at_back)
+                  _shared_state->connection_bodies().push_back(body->group_key(), body);
+                else
+                  _shared_state->connection_bodies().push_front(body->group_key(), body);
+                nolock_index_connection(body);
+              }
+              nolock_publish_state(lock_free_emission());
+            }
+          }
+          pending.clear();
+          disconnect_by_signal(other_bodies.begin(), other_bodies.end());
+        }
+        // disconnects the pending connections of a batch which is not committed
+        void cancel_batch(pending_connection_list &pending) const
+        {
+          std::vector<shared_ptr<connection_body_base> > bodies;
+          bodies.reserve(pending.size());
+          for(std::size_t i = 0; i < pending.size(); ++i)
+            bodies.push_back(pending[i].body);
+          pending.clear();
+          disconnect_by_signal(bodies.begin(), bodies.end());
         }
       private:
         typedef Mutex mutex_type;
+        // true if invocations read the slot list without locking _mutex
+        typedef mpl::bool_<is_rcu_mutex<Mutex>::value> lock_free_emission;
+        // true if invocations leave disconnected slots for collect_garbage
+        typedef mpl::bool_<GarbageCollection::deferred> defer_collection;
+        // true if the combiner only calls every slot, so invocations can call
+        // them directly instead of through slot_call_iterators
+        typedef mpl::bool_<is_same<Combiner, optional_last_value<void> >::value ||
+          is_same<Combiner, last_value<void> >::value> direct_void_emission;
+        // The signal's mutex, shared with its connection bodies, which
+        // keep the counts up to date as they are disconnected.
+        class counted_mutex: public mutex_type
+        {
+        public:
+          connection_counts counts;
+        };
 
         // slot_invoker is passed to slot_call_iterator_t to run slots
 #ifdef BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -384,16 +584,19 @@ namespace boost
         {
         public:
           invocation_state(const connection_list_type &connections_in,
-            const combiner_type &combiner_in): _connection_bodies(new connection_list_type(connections_in)),
-            _combiner(new combiner_type(combiner_in))
+            const combiner_type &combiner_in, const allocator_type &alloc):
+            _connection_bodies(boost::allocate_shared<connection_list_type>(alloc, connections_in)),
+            _combiner(boost::allocate_shared<combiner_type>(alloc, combiner_in))
           {}
-          invocation_state(const invocation_state &other, const connection_list_type &connections_in):
-            _connection_bodies(new connection_list_type(connections_in)),
+          invocation_state(const invocation_state &other, const connection_list_type &connections_in,
+            const allocator_type &alloc):
+            _connection_bodies(boost::allocate_shared<connection_list_type>(alloc, connections_in)),
             _combiner(other._combiner)
           {}
-          invocation_state(const invocation_state &other, const combiner_type &combiner_in):
+          invocation_state(const invocation_state &other, const combiner_type &combiner_in,
+            const allocator_type &alloc):
             _connection_bodies(other._connection_bodies),
-            _combiner(new combiner_type(combiner_in))
+            _combiner(boost::allocate_shared<combiner_type>(alloc, combiner_in))
           {}
           connection_list_type & connection_bodies() { return *_connection_bodies; }
           const connection_list_type & connection_bodies() const { return *_connection_bodies; }
@@ -405,15 +608,54 @@ namespace boost
           shared_ptr<connection_list_type> _connection_bodies;
           shared_ptr<combiner_type> _combiner;
         };
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        // a single_threaded signal holds its invocation state through a local_shared_ptr,
+        // so the copy every invocation takes doesn't count atomically
+        typedef typename mpl::if_<is_single_threaded<Mutex>, local_shared_ptr<invocation_state>,
+          shared_ptr<invocation_state> >::type invocation_state_ptr;
+#else
+        typedef shared_ptr<invocation_state> invocation_state_ptr;
+#endif
+        template<typename Source, typename Part>
+        static invocation_state_ptr make_invocation_state(const allocator_type &alloc,
+          const Source &source, const Part &part)
+        {
+          return make_invocation_state(alloc, source, part,
+            mpl::bool_<is_same<invocation_state_ptr, shared_ptr<invocation_state> >::value>());
+        }
+        template<typename Source, typename Part>
+        static shared_ptr<invocation_state> make_invocation_state(const allocator_type &alloc,
+          const Source &source, const Part &part, mpl::true_ /* shared */)
+        {
+          return boost::allocate_shared<invocation_state>(alloc, source, part, alloc);
+        }
+        static bool unique_state(const shared_ptr<invocation_state> &state)
+        {
+          return state.unique();
+        }
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+        template<typename Source, typename Part>
+        static local_shared_ptr<invocation_state> make_invocation_state(const allocator_type &alloc,
+          const Source &source, const Part &part, mpl::false_ /* shared */)
+        {
+          return boost::allocate_local_shared<invocation_state>(alloc, source, part, alloc);
+        }
+        static bool unique_state(const local_shared_ptr<invocation_state> &state)
+        {
+          return state.local_use_count() == 1;
+        }
+#endif
         // Destructor of invocation_janitor does some cleanup when a signal invocation completes.
         // Code can't be put directly in signal's operator() due to complications from void return types.
+        // SlotCounts is whatever counts the connected and disconnected slots the invocation saw.
+        template<typename SlotCounts = slot_call_iterator_cache_type>
         class invocation_janitor: noncopyable
         {
         public:
           typedef BOOST_SIGNALS2_SIGNAL_IMPL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) signal_type;
           invocation_janitor
           (
-            const slot_call_iterator_cache_type &cache,
+            const SlotCounts &cache,
             const signal_type &sig,
             const connection_list_type *connection_bodies
           ):_cache(cache), _sig(sig), _connection_bodies(connection_bodies)
@@ -421,27 +663,189 @@ namespace boost
           ~invocation_janitor()
           {
             // force a full cleanup of disconnected slots if there are too many
-            if(_cache.disconnected_slot_count > _cache.connected_slot_count)
+            if(defer_collection::value == false &&
+              _cache.disconnected_slot_count > _cache.connected_slot_count)
             {
-              _sig.force_cleanup_connections(_connection_bodies);
+              _sig.force_cleanup_connections(_connection_bodies, lock_free_emission());
             }
           }
         private:
-          const slot_call_iterator_cache_type &_cache;
+          const SlotCounts &_cache;
           const signal_type &_sig;
           const connection_list_type *_connection_bodies;
         };
 
+        result_type invoke(const slot_invoker &invoker, mpl::bool_<false> /* direct_void_emission */)
+        {
+          invocation_state_ptr local_state =
+            get_invocation_state(lock_free_emission());
+          slot_call_iterator_cache_type cache(invoker);
+          invocation_janitor<> janitor(cache, *this, &local_state->connection_bodies());
+          return detail::combiner_invoker<typename combiner_type::result_type>()
+            (
+              local_state->combiner(),
+              slot_call_iterator(local_state->connection_bodies().begin(), local_state->connection_bodies().end(), cache),
+              slot_call_iterator(local_state->connection_bodies().end(), local_state->connection_bodies().end(), cache)
+            );
+        }
+        result_type invoke(const slot_invoker &invoker, mpl::bool_<false> /* direct_void_emission */) const
+        {
+          invocation_state_ptr local_state =
+            get_invocation_state(lock_free_emission());
+          slot_call_iterator_cache_type cache(invoker);
+          invocation_janitor<> janitor(cache, *this, &local_state->connection_bodies());
+          return detail::combiner_invoker<typename combiner_type::result_type>()
+            (
+              local_state->combiner(),
+              slot_call_iterator(local_state->connection_bodies().begin(), local_state->connection_bodies().end(), cache),
+              slot_call_iterator(local_state->connection_bodies().end(), local_state->connection_bodies().end(), cache)
+            );
+        }
+        // the combiner is stateless and returns nothing, so is left out
+        result_type invoke(const slot_invoker &invoker, mpl::bool_<true> /* direct_void_emission */) const
+        {
+          invocation_state_ptr local_state =
+            get_invocation_state(lock_free_emission());
+          direct_call_state state;
+          invocation_janitor<direct_call_state> janitor(state, *this, &local_state->connection_bodies());
+          detail::call_slots_directly(invoker, local_state->connection_bodies().begin(),
+            local_state->connection_bodies().end(), state);
+          return result_type();
+        }
+        // one emission of a batch, over slots which are already locked
+        result_type batch_invoke(invocation_state &state, const batch_slots_type &slots
+          BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS)
+          BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS)) const
+        {
+          slot_invoker invoker = slot_invoker(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+          batch_call_cache_type cache(invoker);
+          return detail::combiner_invoker<typename combiner_type::result_type>()
+            (
+              state.combiner(),
+              batch_call_iterator(slots.begin(), slots.end(), cache),
+              batch_call_iterator(slots.end(), slots.end(), cache)
+            );
+        }
+        // The arguments of a signal with a single argument are batched on their
+        // own, otherwise each element of a batch is a tuple of the arguments,
+        // whose elements are found with boost::tuples::get or std::get.
+#ifdef BOOST_NO_CXX11_VARIADIC_TEMPLATES
+#if BOOST_SIGNALS2_NUM_ARGS == 1
+#define BOOST_SIGNALS2_BATCH_ARGS(arity) args
+#else
+// get<n>(args)
+#define BOOST_SIGNALS2_BATCH_ARG(z, n, data) get<n>(args)
+#define BOOST_SIGNALS2_BATCH_ARGS(arity) BOOST_PP_ENUM(arity, BOOST_SIGNALS2_BATCH_ARG, ~)
+#endif
+        template<typename ArgumentPack>
+        result_type emit_batch_element(invocation_state &state, const batch_slots_type &slots,
+          ArgumentPack & BOOST_PP_EXPR_IF(BOOST_SIGNALS2_NUM_ARGS, args)) const
+        {
+          using boost::tuples::get;
+#ifndef BOOST_NO_CXX11_HDR_TUPLE
+          using std::get;
+#endif
+          return batch_invoke(state, slots BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS)
+            BOOST_SIGNALS2_BATCH_ARGS(BOOST_SIGNALS2_NUM_ARGS));
+        }
+#undef BOOST_SIGNALS2_BATCH_ARGS
+#ifdef BOOST_SIGNALS2_BATCH_ARG
+#undef BOOST_SIGNALS2_BATCH_ARG
+#endif
+#else // BOOST_NO_CXX11_VARIADIC_TEMPLATES
+        template<typename ArgumentPack>
+        result_type emit_batch_element(invocation_state &state, const batch_slots_type &slots,
+          ArgumentPack &args) const
+        {
+          return emit_batch_element(state, slots, args, mpl::bool_<sizeof...(Args) == 1>());
+        }
+        template<typename ArgumentPack>
+        result_type emit_batch_element(invocation_state &state, const batch_slots_type &slots,
+          ArgumentPack &args, mpl::bool_<true> /* single argument */) const
+        {
+          return batch_invoke(state, slots, args);
+        }
+        template<typename ArgumentPack>
+        result_type emit_batch_element(invocation_state &state, const batch_slots_type &slots,
+          ArgumentPack &args, mpl::bool_<false> /* single argument */) const
+        {
+          typedef typename make_unsigned_meta_array<sizeof...(Args)>::type indices_type;
+          return emit_batch_element(state, slots, args, indices_type());
+        }
+        template<typename ArgumentPack, unsigned ... indices>
+        result_type emit_batch_element(invocation_state &state, const batch_slots_type &slots,
+          ArgumentPack &args, unsigned_meta_array<indices...>) const
+        {
+          using boost::tuples::get;
+#ifndef BOOST_NO_CXX11_HDR_TUPLE
+          using std::get;
+#endif
+          return batch_invoke(state, slots, get<indices>(args)...);
+        }
+#endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
+        // identifies the connections which may be removed from the slot list
+        class disconnected_connection
+        {
+        public:
+          disconnected_connection(garbage_collecting_lock<mutex_type> &lock, bool grab_tracked):
+            _lock(lock), _grab_tracked(grab_tracked)
+          {}
+          bool operator()(const connection_body_type &body) const
+          {
+            if(_grab_tracked)
+              body->disconnect_expired_slot(_lock);
+            if(body->nolock_nograb_connected()) return false;
+            nolock_release_handle(body);
+            return true;
+          }
+        private:
+          garbage_collecting_lock<mutex_type> &_lock;
+          bool _grab_tracked;
+        };
+        // frees the slot_table entry of a connection leaving the slot list
+        static void nolock_release_handle(const connection_body_type &body)
+        {
+          if(body->handle_index() == 0) return;
+          body->counts()->handles.load(memory_order_relaxed)->nolock_release(body->handle_index());
+        }
+        // makes sure a connection can be given a handle without throwing
+        void nolock_reserve_handle()
+        {
+          slot_table *table = _mutex->counts.handles.load(memory_order_relaxed);
+          if(table == 0)
+          {
+            table = new slot_table();
+            _mutex->counts.handles.store(table, memory_order_release);
+          }
+          table->nolock_reserve();
+        }
+        connection_handle nolock_register_handle(const connection_body_type &body)
+        {
+          slot_table *table = _mutex->counts.handles.load(memory_order_relaxed);
+          boost::uint32_t generation;
+          const boost::uint32_t index = table->nolock_acquire(body.get(),
+            body->tracked_object_count() != 0, generation);
+          body->nolock_set_handle(index, generation);
+          return connection_handle(index, generation);
+        }
+        // clean up all disconnected connections in a single pass
+        void nolock_cleanup_all_connections(garbage_collecting_lock<mutex_type> &lock,
+          bool grab_tracked) const
+        {
+          BOOST_ASSERT(unique_state(_shared_state));
+          _shared_state->connection_bodies().remove_if(disconnected_connection(lock, grab_tracked));
+          _garbage_collector_it = _shared_state->connection_bodies().end();
+        }
         // clean up disconnected connections
         void nolock_cleanup_connections_from(garbage_collecting_lock<mutex_type> &lock,
           bool grab_tracked,
-          const typename connection_list_type::iterator &begin, unsigned count = 0) const
+          const typename connection_list_type::iterator &begin, unsigned count) const
         {
-          BOOST_ASSERT(_shared_state.unique());
+          BOOST_ASSERT(unique_state(_shared_state));
           typename connection_list_type::iterator it;
           unsigned i;
           for(it = begin, i = 0;
-            it != _shared_state->connection_bodies().end() && (count == 0 || i < count);
+            it != _shared_state->connection_bodies().end() && i < count;
             ++i)
           {
             bool connected;
@@ -450,6 +854,7 @@ namespace boost
             connected = (*it)->nolock_nograb_connected();
             if(connected == false)
             {
+              nolock_release_handle(*it);
               it = _shared_state->connection_bodies().erase((*it)->group_key(), it);
             }else
             {
@@ -462,7 +867,7 @@ namespace boost
         void nolock_cleanup_connections(garbage_collecting_lock<mutex_type> &lock,
           bool grab_tracked, unsigned count) const
         {
-          BOOST_ASSERT(_shared_state.unique());
+          BOOST_ASSERT(unique_state(_shared_state));
           typename connection_list_type::iterator begin;
           if(_garbage_collector_it == _shared_state->connection_bodies().end())
           {
@@ -477,44 +882,142 @@ namespace boost
         */
         void nolock_force_unique_connection_list(garbage_collecting_lock<mutex_type> &lock)
         {
-          if(_shared_state.unique() == false)
+          if(unique_state(_shared_state) == false)
           {
-            _shared_state = boost::make_shared<invocation_state>(*_shared_state, _shared_state->connection_bodies());
-            nolock_cleanup_connections_from(lock, true, _shared_state->connection_bodies().begin());
-          }else
+            _shared_state = make_invocation_state(_allocator,
+              *_shared_state, _shared_state->connection_bodies());
+            /* Copying the slot list took a pass over it, which a full cleanup
+            costs little more than.  A list sharing its storage with the copy
+            was cheap to copy, and is cleaned up as gradually as a unique one. */
+            if(nolock_rebase_garbage_collector(detail::shares_storage<connection_list_type>()) == false)
+            {
+              nolock_cleanup_all_connections(lock, true);
+              return;
+            }
+          }
+          if(defer_collection::value == false)
           {
             /* We need to try and check more than just 1 connection here to avoid corner
             cases where certain repeated connect/disconnect patterns cause the slot
             list to grow without limit. */
             nolock_cleanup_connections(lock, true, 2);
+          }else if(_shared_state->connection_bodies().size() >
+            2 * _mutex->counts.connected.load(memory_order_relaxed))
+          {
+            /* Compacting only once disconnected slots outnumber the connected
+            ones bounds the slot list at constant amortized cost per connection. */
+            nolock_cleanup_all_connections(lock, true);
           }
         }
+        bool nolock_rebase_garbage_collector(mpl::bool_<false> /* shares_storage */)
+        {
+          return false;
+        }
+        // moves the garbage collector's position over to the new copy of the slot list
+        bool nolock_rebase_garbage_collector(mpl::bool_<true> /* shares_storage */)
+        {
+          _garbage_collector_it = _shared_state->connection_bodies().rebase(_garbage_collector_it);
+          return true;
+        }
         // force a full cleanup of the connection list
-        void force_cleanup_connections(const connection_list_type *connection_bodies) const
+        void force_cleanup_connections(const connection_list_type *connection_bodies,
+          mpl::bool_<false> /* lock_free_emission */) const
         {
           garbage_collecting_lock<mutex_type> list_lock(*_mutex);
+          nolock_force_cleanup_connections(list_lock, connection_bodies);
+        }
+        // an invocation which never locks must not block on the cleanup either,
+        // so leave it to a later invocation if a writer holds the mutex
+        void force_cleanup_connections(const connection_list_type *connection_bodies,
+          mpl::bool_<true> /* lock_free_emission */) const
+        {
+          garbage_collecting_lock<mutex_type> list_lock(*_mutex, try_to_lock_t());
+          if(list_lock.owns_lock() == false) return;
+          nolock_force_cleanup_connections(list_lock, connection_bodies);
+        }
+        void nolock_force_cleanup_connections(garbage_collecting_lock<mutex_type> &list_lock,
+          const connection_list_type *connection_bodies) const
+        {
           // if the connection list passed in as a parameter is no longer in use,
           // we don't need to do any cleanup.
           if(&_shared_state->connection_bodies() != connection_bodies)
           {
             return;
           }
-          if(_shared_state.unique() == false)
+          if(unique_state(_shared_state) == false)
           {
-            _shared_state = boost::make_shared<invocation_state>(*_shared_state, _shared_state->connection_bodies());
+            _shared_state = make_invocation_state(_allocator,
+              *_shared_state, _shared_state->connection_bodies());
           }
-          nolock_cleanup_connections_from(list_lock, false, _shared_state->connection_bodies().begin());
+          nolock_cleanup_all_connections(list_lock, false);
+          nolock_publish_state(lock_free_emission());
+        }
+        invocation_state_ptr get_readable_state() const
+        {
+          return get_readable_state(lock_free_emission());
         }
-        shared_ptr<invocation_state> get_readable_state() const
+        invocation_state_ptr get_readable_state(mpl::bool_<false> /* lock_free_emission */) const
         {
           unique_lock<mutex_type> list_lock(*_mutex);
           return _shared_state;
         }
+        invocation_state_ptr get_readable_state(mpl::bool_<true> /* lock_free_emission */) const
+        {
+          return _published_state.load();
+        }
+        invocation_state_ptr get_invocation_state(mpl::bool_<false> /* lock_free_emission */) const
+        {
+          garbage_collecting_lock<mutex_type> list_lock(*_mutex);
+          // only clean up if it is safe to do so
+          if(defer_collection::value == false && unique_state(_shared_state))
+            nolock_cleanup_connections(list_lock, false, 1);
+          /* Make a local copy of _shared_state while holding mutex, so we are
+          thread safe against the combiner or connection list getting modified
+          during invocation. */
+          return _shared_state;
+        }
+        /* The published copy of _shared_state keeps it from ever being unique, so
+        every modification of the connection list or combiner is made to a new copy,
+        which is then published for invocations to pick up. */
+        invocation_state_ptr get_invocation_state(mpl::bool_<true> /* lock_free_emission */) const
+        {
+          return _published_state.load();
+        }
+        void nolock_publish_state(mpl::bool_<false> /* lock_free_emission */) const
+        {}
+        void nolock_publish_state(mpl::bool_<true> /* lock_free_emission */) const
+        {
+          _published_state.store(_shared_state);
+        }
         connection_body_type create_new_connection(garbage_collecting_lock<mutex_type> &lock,
           const slot_type &slot)
         {
           nolock_force_unique_connection_list(lock);
-          return boost::make_shared<connection_body<group_key_type, slot_type, Mutex> >(slot, _mutex);
+          return new_connection_body(slot);
+        }
+        connection_body_type new_connection_body(const slot_type &slot) const
+        {
+          return boost::allocate_shared<connection_body<group_key_type, slot_type, Mutex> >(_allocator,
+            slot, _mutex, &_mutex->counts);
+        }
+        connection add_pending_body(pending_connection_list &pending,
+          const connection_body_type &body, connect_position position) const
+        {
+          pending.push_back(pending_connection(body, position));
+          body->nolock_count();
+          return connection(body);
+        }
+        // disconnects any connection whose tracked objects have expired
+        void check_tracked_connections() const
+        {
+          invocation_state_ptr local_state =
+            get_readable_state();
+          typename connection_list_type::iterator it;
+          for(it = local_state->connection_bodies().begin();
+            it != local_state->connection_bodies().end(); ++it)
+          {
+            (*it)->connected();
+          }
         }
         void do_disconnect(const group_type &group, mpl::bool_<true> /* is_group */)
         {
@@ -523,61 +1026,153 @@ namespace boost
         template<typename T>
         void do_disconnect(const T &slot, mpl::bool_<false> /* is_group */)
         {
-          shared_ptr<invocation_state> local_state =
+          // a function passed by name, without &, is taken by reference
+          typedef typename decay<T>::type target_type;
+          typedef mpl::bool_<(is_pointer<target_type>::value &&
+            is_function<typename remove_pointer<target_type>::type>::value)> is_function_pointer;
+          do_disconnect_slot(slot, is_function_pointer());
+        }
+        template<typename T>
+        void do_disconnect_slot(const T &slot, mpl::bool_<false> /* is_function_pointer */)
+        {
+          invocation_state_ptr local_state =
             get_readable_state();
           typename connection_list_type::iterator it;
           for(it = local_state->connection_bodies().begin();
             it != local_state->connection_bodies().end(); ++it)
           {
             garbage_collecting_lock<connection_body_base> lock(**it);
-            if((*it)->nolock_nograb_connected() == false) continue;
-            if((*it)->slot().slot_function().contains(slot))
+            nolock_disconnect_if_contains(lock, *it, slot);
+          }
+        }
+        // Function pointers are looked up in an index of the slots by target,
+        // built the first time a slot is disconnected by a function pointer of
+        // its type, then kept up to date as slots are connected.
+        template<typename T>
+        void do_disconnect_slot(const T &function, mpl::bool_<true> /* is_function_pointer */)
+        {
+          typedef typename decay<T>::type function_pointer_type;
+          const function_pointer_type slot = function;
+          garbage_collecting_lock<mutex_type> lock(*_mutex);
+          slot_index_type &index = nolock_slot_index(&classify_slot_target<function_pointer_type>);
+          const std::size_t hash = hash_function_pointer(slot);
+          std::pair<typename slot_index_type::target_iterator, typename slot_index_type::target_iterator>
+            targets = index.targets(hash);
+          for(; targets.first != targets.second; ++targets.first)
+            nolock_disconnect_if_contains(lock, targets.first->second, slot);
+          typename slot_index_type::wrapped_iterator it;
+          for(it = index.wrapped_begin(); it != index.wrapped_end(); ++it)
+            nolock_disconnect_if_contains(lock, *it, slot);
+          // drops what this disconnected, and anything else disconnected
+          // which a later disconnect of the same target would have to skip
+          index.prune(hash);
+        }
+        template<typename M, typename T>
+        static void nolock_disconnect_if_contains(garbage_collecting_lock<M> &lock,
+          const connection_body_type &body, const T &slot)
+        {
+          if(body->nolock_nograb_connected() == false) return;
+          if(body->slot().slot_function().contains(slot))
+          {
+            body->nolock_disconnect(lock);
+          }else
+          { // check for wrapped extended slot
+            const bound_extended_slot_function_type *fp;
+            fp = body->slot().slot_function().template target<bound_extended_slot_function_type>();
+            if(fp && fp->contains(slot))
             {
-              (*it)->nolock_disconnect(lock);
+              body->nolock_disconnect(lock);
             }else
-            { // check for wrapped extended slot
-              bound_extended_slot_function_type *fp;
-              fp = (*it)->slot().slot_function().template target<bound_extended_slot_function_type>();
+            { // check for wrapped signal
+              const weak_signal_type *fp;
+              fp = body->slot().slot_function().template target<weak_signal_type>();
               if(fp && fp->contains(slot))
               {
-                (*it)->nolock_disconnect(lock);
-              }else
-              { // check for wrapped signal
-                weak_signal_type *fp;
-                fp = (*it)->slot().slot_function().template target<weak_signal_type>();
-                if(fp && fp->contains(slot))
-                {
-                  (*it)->nolock_disconnect(lock);
-                }
+                body->nolock_disconnect(lock);
               }
             }
           }
         }
+        // the classifier of the slot_index for targets of type T
+        template<typename T>
+        static slot_target_kind classify_slot_target(const connection_body_type &body, std::size_t &hash)
+        {
+          const slot_function_type &f = body->slot().slot_function();
+          if(const T *target = f.template target<T>())
+          {
+            hash = hash_function_pointer(*target);
+            return indexed_target;
+          }
+          if(f.template target<bound_extended_slot_function_type>() ||
+            f.template target<weak_signal_type>())
+            return wrapped_target;
+          return unrelated_target;
+        }
+        slot_index_type & nolock_slot_index(typename slot_index_type::classifier_type classifier)
+        {
+          for(std::size_t i = 0; i < _slot_indexes.size(); ++i)
+          {
+            if(_slot_indexes[i].classifier() == classifier) return _slot_indexes[i];
+          }
+          slot_index_type index(classifier);
+          typename connection_list_type::iterator it;
+          for(it = _shared_state->connection_bodies().begin();
+            it != _shared_state->connection_bodies().end(); ++it)
+          {
+            if((*it)->nolock_nograb_connected()) index.add(*it);
+          }
+          _slot_indexes.push_back(index);
+          return _slot_indexes.back();
+        }
+        void nolock_index_connection(const connection_body_type &body)
+        {
+          try
+          {
+            for(std::size_t i = 0; i < _slot_indexes.size(); ++i)
+            {
+              _slot_indexes[i].add(body);
+              if(_slot_indexes[i].size() > 2 * _mutex->counts.connected.load(memory_order_relaxed) + 16)
+                _slot_indexes[i].prune();
+            }
+          }
+          catch(...)
+          {
+            // the indexes are only a cache, so rather than fail the
+            // connection they are dropped, to be rebuilt when next needed
+            _slot_indexes.clear();
+          }
+        }
         // connect slot
         connection nolock_connect(garbage_collecting_lock<mutex_type> &lock,
-          const slot_type &slot, connect_position position)
+          const slot_type &slot, connect_position position, connection_handle *handle = 0)
         {
           connection_body_type newConnectionBody =
             create_new_connection(lock, slot);
+          if(handle) nolock_reserve_handle();
           group_key_type group_key;
           if(position == at_back)
           {
-            group_key.first = back_ungrouped_slots;
+            group_key = detail::group_key<Group>::ungrouped(back_ungrouped_slots);
             _shared_state->connection_bodies().push_back(group_key, newConnectionBody);
           }else
           {
-            group_key.first = front_ungrouped_slots;
+            group_key = detail::group_key<Group>::ungrouped(front_ungrouped_slots);
             _shared_state->connection_bodies().push_front(group_key, newConnectionBody);
           }
           newConnectionBody->set_group_key(group_key);
+          if(handle) *handle = nolock_register_handle(newConnectionBody);
+          newConnectionBody->nolock_count();
+          nolock_index_connection(newConnectionBody);
+          nolock_publish_state(lock_free_emission());
           return connection(newConnectionBody);
         }
         connection nolock_connect(garbage_collecting_lock<mutex_type> &lock,
           const group_type &group,
-          const slot_type &slot, connect_position position)
+          const slot_type &slot, connect_position position, connection_handle *handle = 0)
         {
           connection_body_type newConnectionBody =
             create_new_connection(lock, slot);
+          if(handle) nolock_reserve_handle();
           // update map to first connection body in group if needed
           group_key_type group_key(grouped_slots, group);
           newConnectionBody->set_group_key(group_key);
@@ -588,15 +1183,26 @@ namespace boost
           {
             _shared_state->connection_bodies().push_front(group_key, newConnectionBody);
           }
+          if(handle) *handle = nolock_register_handle(newConnectionBody);
+          newConnectionBody->nolock_count();
+          nolock_index_connection(newConnectionBody);
+          nolock_publish_state(lock_free_emission());
           return connection(newConnectionBody);
         }
 
+        // indexes of the slots by target, for disconnect(slot), guarded by _mutex
+        std::vector<slot_index_type> _slot_indexes;
+        // every connection body, slot list and combiner copy is allocated from this
+        const allocator_type _allocator;
         // _shared_state is mutable so we can do force_cleanup_connections during a const invocation
-        mutable shared_ptr<invocation_state> _shared_state;
+        mutable invocation_state_ptr _shared_state;
         mutable typename connection_list_type::iterator _garbage_collector_it;
+        // snapshot of _shared_state read by invocations when lock_free_emission is true
+        mutable typename mpl::if_<lock_free_emission,
+          rcu_shared_ptr<invocation_state>, mpl::void_>::type _published_state;
         // connection list mutex must never be locked when attempting a blocking lock on a slot,
         // or you could deadlock.
-        const boost::shared_ptr<mutex_type> _mutex;
+        const boost::shared_ptr<counted_mutex> _mutex;
       };
 
     }
@@ -615,6 +1221,7 @@ namespace boost
       typedef typename impl_class::weak_signal_type weak_signal_type;
       friend class detail::BOOST_SIGNALS2_WEAK_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)
         <BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION>;
+      template<typename> friend class connection_batch;
 
       typedef SlotFunction slot_function_type;
       // typedef slotN<Signature, SlotFunction> slot_type;
@@ -626,6 +1233,7 @@ namespace boost
       typedef typename impl_class::result_type result_type;
       typedef Group group_type;
       typedef GroupCompare group_compare_type;
+      typedef Allocator allocator_type;
       typedef typename impl_class::slot_call_iterator
         slot_call_iterator;
       typedef typename mpl::identity<BOOST_SIGNALS2_SIGNATURE_FUNCTION_TYPE(BOOST_SIGNALS2_NUM_ARGS)>::type signature_type;
@@ -663,9 +1271,15 @@ namespace boost
 
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
 
-      BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)(const combiner_type &combiner_arg = combiner_type(),
-        const group_compare_type &group_compare = group_compare_type()):
-        _pimpl(new impl_class(combiner_arg, group_compare))
+      // the signal's internals are only created once they are first needed,
+      // typically by the first connect
+      BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)():
+        _pimpl(initial_pimpl(lazy_construction()))
+      {}
+      BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)(const combiner_type &combiner_arg,
+        const group_compare_type &group_compare = group_compare_type(),
+        const allocator_type &alloc = allocator_type()):
+        _pimpl(boost::allocate_shared<impl_class>(alloc, combiner_arg, group_compare, alloc))
       {}
       virtual ~BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)()
       {
@@ -676,8 +1290,7 @@ namespace boost
       BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)(
         BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) && other) BOOST_NOEXCEPT
       {
-        using std::swap;
-        swap(_pimpl, other._pimpl);
+        _pimpl.swap(other._pimpl);
       }
       
       BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) & 
@@ -688,80 +1301,135 @@ namespace boost
           return *this;
         }
         _pimpl.reset();
-        using std::swap;
-        swap(_pimpl, rhs._pimpl);
+        _pimpl.swap(rhs._pimpl);
         return *this;
       }
 #endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
       
       connection connect(const slot_type &slot, connect_position position = at_back)
       {
-        return (*_pimpl).connect(slot, position);
+        return (*created_pimpl()).connect(slot, position);
       }
       connection connect(const group_type &group,
         const slot_type &slot, connect_position position = at_back)
       {
-        return (*_pimpl).connect(group, slot, position);
+        return (*created_pimpl()).connect(group, slot, position);
+      }
+      connection_handle connect_handle(const slot_type &slot, connect_position position = at_back)
+      {
+        return (*created_pimpl()).connect_handle(slot, position);
+      }
+      connection_handle connect_handle(const group_type &group,
+        const slot_type &slot, connect_position position = at_back)
+      {
+        return (*created_pimpl()).connect_handle(group, slot, position);
       }
       connection connect_extended(const extended_slot_type &slot, connect_position position = at_back)
       {
-        return (*_pimpl).connect_extended(slot, position);
+        return (*created_pimpl()).connect_extended(slot, position);
       }
       connection connect_extended(const group_type &group,
         const extended_slot_type &slot, connect_position position = at_back)
       {
-        return (*_pimpl).connect_extended(group, slot, position);
+        return (*created_pimpl()).connect_extended(group, slot, position);
       }
       void disconnect_all_slots()
       {
-        if (_pimpl.get() == 0) return;
-        (*_pimpl).disconnect_all_slots();
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return;
+        (*pimpl).disconnect_all_slots();
       }
       void disconnect(const group_type &group)
       {
-        if (_pimpl.get() == 0) return;
-        (*_pimpl).disconnect(group);
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return;
+        (*pimpl).disconnect(group);
       }
       template <typename T>
       void disconnect(const T &slot)
       {
-        if (_pimpl.get() == 0) return;
-        (*_pimpl).disconnect(slot);
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return;
+        (*pimpl).disconnect(slot);
+      }
+      void disconnect(const connection_handle &handle)
+      {
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return;
+        (*pimpl).disconnect(handle);
+      }
+      bool connected(const connection_handle &handle) const
+      {
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return false;
+        return (*pimpl).connected(handle);
+      }
+      connection get_connection(const connection_handle &handle) const
+      {
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return connection();
+        return (*pimpl).get_connection(handle);
       }
       result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
       {
-        return (*_pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return invoke_unconnected(stateless_unconnected_invocation()
+          BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS) BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+        return (*pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
       }
       result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS)) const
       {
-        return (*_pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return invoke_unconnected(stateless_unconnected_invocation()
+          BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS) BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+        return (*pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+      }
+      template<typename InputIterator>
+      void emit_batch(InputIterator first, InputIterator last) const
+      {
+        (*created_pimpl()).emit_batch(first, last);
+      }
+      template<typename InputIterator, typename OutputIterator>
+      OutputIterator emit_batch(InputIterator first, InputIterator last, OutputIterator results) const
+      {
+        return (*created_pimpl()).emit_batch(first, last, results);
       }
       std::size_t num_slots() const
       {
-        if (_pimpl.get() == 0) return 0;
-        return (*_pimpl).num_slots();
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return 0;
+        return (*pimpl).num_slots();
       }
       bool empty() const
       {
-        if (_pimpl.get() == 0) return true;
-        return (*_pimpl).empty();
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return true;
+        return (*pimpl).empty();
       }
       combiner_type combiner() const
       {
-        return (*_pimpl).combiner();
+        return (*created_pimpl()).combiner();
       }
       void set_combiner(const combiner_type &combiner_arg)
       {
-        return (*_pimpl).set_combiner(combiner_arg);
+        return (*created_pimpl()).set_combiner(combiner_arg);
+      }
+      std::size_t collect_garbage(std::size_t budget = (std::numeric_limits<std::size_t>::max)())
+      {
+        impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return 0;
+        return (*pimpl).collect_garbage(budget);
       }
       void swap(BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) & other) BOOST_NOEXCEPT
       {
-        using std::swap;
-        swap(_pimpl, other._pimpl);
+        _pimpl.swap(other._pimpl);
       }
       bool operator==(const BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) & other) const
       {
-        return _pimpl.get() == other._pimpl.get();
+        // signals without internals are only equal to themselves
+        const impl_class *pimpl = _pimpl.get();
+        if (pimpl == 0) return this == &other;
+        return pimpl == other._pimpl.get();
       }
       bool null() const
       {
@@ -770,9 +1438,74 @@ namespace boost
     protected:
       virtual shared_ptr<void> lock_pimpl() const
       {
-        return _pimpl;
+        return shared_pimpl();
       }
     private:
+      // whether a signal can create its internals for itself, from default
+      // constructed arguments.  Without decltype, is_default_constructible
+      // is only true for PODs, so other signals create them up front.
+      typedef mpl::bool_<is_default_constructible<combiner_type>::value &&
+        is_default_constructible<group_compare_type>::value &&
+        is_default_constructible<allocator_type>::value> lazy_construction;
+      // whether invoking a signal without internals can use a throwaway
+      // combiner, rather than creating the internals to use their combiner
+      typedef mpl::bool_<lazy_construction::value && is_empty<combiner_type>::value &&
+        has_trivial_constructor<combiner_type>::value> stateless_unconnected_invocation;
+
+      static shared_ptr<impl_class> create_pimpl()
+      {
+        const allocator_type alloc = allocator_type();
+        return boost::allocate_shared<impl_class>(alloc, combiner_type(), group_compare_type(), alloc);
+      }
+      static shared_ptr<impl_class> initial_pimpl(mpl::bool_<true> /* lazy_construction */)
+      {
+        return shared_ptr<impl_class>();
+      }
+      static shared_ptr<impl_class> initial_pimpl(mpl::bool_<false> /* lazy_construction */)
+      {
+        return create_pimpl();
+      }
+      const shared_ptr<impl_class> & created_pimpl(mpl::bool_<true> /* lazy_construction */) const
+      {
+        return _pimpl.get_or_create(&create_pimpl);
+      }
+      // a signal which can't create its internals was given them by its
+      // constructor, and is only without them once it has been moved from
+      shared_ptr<impl_class> created_pimpl(mpl::bool_<false> /* lazy_construction */) const
+      {
+        return _pimpl.load();
+      }
+      shared_ptr<impl_class> shared_pimpl() const
+      {
+        return created_pimpl(lazy_construction());
+      }
+      impl_class * created_pimpl() const
+      {
+        return created_pimpl(lazy_construction()).get();
+      }
+      static result_type invoke_unconnected(mpl::bool_<true> /* stateless_unconnected_invocation */
+        BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS) BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
+      {
+        return impl_class::invoke_unconnected(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+      }
+      // a combiner which may be costly to construct or keep state is only
+      // ever the one held by the internals, so they are created for it.  A
+      // signal which can't create its internals is never without them.
+      result_type invoke_unconnected(mpl::bool_<false> /* stateless_unconnected_invocation */
+        BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS) BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
+      {
+        impl_class *pimpl = created_pimpl();
+        BOOST_ASSERT(pimpl != 0);
+        return (*pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+      }
+      result_type invoke_unconnected(mpl::bool_<false> /* stateless_unconnected_invocation */
+        BOOST_SIGNALS2_PP_COMMA_IF(BOOST_SIGNALS2_NUM_ARGS) BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS)) const
+      {
+        const impl_class *pimpl = created_pimpl();
+        BOOST_ASSERT(pimpl != 0);
+        return (*pimpl)(BOOST_SIGNALS2_SIGNATURE_ARG_NAMES(BOOST_SIGNALS2_NUM_ARGS));
+      }
+
       // explicit private copy constructor to avoid compiler trying to do implicit conversions to signal
       explicit BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)(
         const BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS) & other) BOOST_NOEXCEPT
@@ -781,8 +1514,7 @@ namespace boost
           BOOST_ASSERT(false);
       }
 
-      shared_ptr<impl_class>
-        _pimpl;
+      detail::lazy_shared_ptr<impl_class> _pimpl;
     };
 
 #ifdef BOOST_NO_CXX11_VARIADIC_TEMPLATES
@@ -815,7 +1547,7 @@ namespace boost
           (const BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)
           <BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION>
           &signal):
-          _weak_pimpl(signal._pimpl)
+          _weak_pimpl(signal.shared_pimpl())
         {}
         result_type operator ()(BOOST_SIGNALS2_SIGNATURE_FULL_ARGS(BOOST_SIGNALS2_NUM_ARGS))
         {
@@ -841,6 +1573,18 @@ namespace boost
         {
           return false;
         }
+        bool expired() const
+        {
+          return _weak_pimpl.expired();
+        }
+        std::size_t collect_garbage(std::size_t budget) const
+        {
+          shared_ptr<detail::BOOST_SIGNALS2_SIGNAL_IMPL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)
+            <BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION> >
+            shared_pimpl(_weak_pimpl.lock());
+          if(shared_pimpl.get() == 0) return 0;
+          return shared_pimpl->collect_garbage(budget);
+        }
       private:
         boost::weak_ptr<detail::BOOST_SIGNALS2_SIGNAL_IMPL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)
           <BOOST_SIGNALS2_SIGNAL_TEMPLATE_INSTANTIATION> > _weak_pimpl;
@@ -874,20 +1618,22 @@ namespace boost
 
       template<unsigned arity, typename Signature, typename Combiner,
         typename Group, typename GroupCompare, typename SlotFunction,
-        typename ExtendedSlotFunction, typename Mutex>
+        typename ExtendedSlotFunction, typename Mutex, typename SlotStorage,
+        typename Allocator, typename GarbageCollection>
       class signalN;
       // partial template specialization
       template<typename Signature, typename Combiner, typename Group,
         typename GroupCompare, typename SlotFunction,
-        typename ExtendedSlotFunction, typename Mutex>
+        typename ExtendedSlotFunction, typename Mutex, typename SlotStorage,
+        typename Allocator, typename GarbageCollection>
       class signalN<BOOST_SIGNALS2_NUM_ARGS, Signature, Combiner, Group,
-        GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex>
+        GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection>
       {
       public:
         typedef BOOST_SIGNALS2_SIGNAL_CLASS_NAME(BOOST_SIGNALS2_NUM_ARGS)<
           BOOST_SIGNALS2_PORTABLE_SIGNATURE(BOOST_SIGNALS2_NUM_ARGS, Signature),
           Combiner, Group,
-          GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex> type;
+          GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection> type;
       };
 
 #endif // BOOST_NO_CXX11_VARIADIC_TEMPLATES
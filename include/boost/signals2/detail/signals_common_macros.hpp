@@ -124,7 +124,10 @@
   typename GroupCompare, \
   typename SlotFunction, \
   typename ExtendedSlotFunction, \
-  typename Mutex
+  typename Mutex, \
+  typename SlotStorage, \
+  typename Allocator, \
+  typename GarbageCollection
 // typename R, typename T1, typename T2, ..., typename TN, typename Combiner = optional_last_value<R>, ...
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_DEFAULTED_DECL(arity) \
   BOOST_SIGNALS2_SIGNATURE_TEMPLATE_DECL(arity), \
@@ -133,7 +136,10 @@
   typename GroupCompare = std::less<Group>, \
   typename SlotFunction = BOOST_SIGNALS2_FUNCTION_N_DECL(arity), \
   typename ExtendedSlotFunction = BOOST_SIGNALS2_EXT_FUNCTION_N_DECL(arity), \
-  typename Mutex = signals2::mutex
+  typename Mutex = signals2::mutex, \
+  typename SlotStorage = signals2::vector_slot_storage, \
+  typename Allocator = std::allocator<void>, \
+  typename GarbageCollection = signals2::eager_garbage_collection
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_SPECIALIZATION_DECL(arity) BOOST_SIGNALS2_SIGNAL_TEMPLATE_DECL(arity)
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_SPECIALIZATION
 
@@ -178,7 +184,10 @@
   typename GroupCompare, \
   typename SlotFunction, \
   typename ExtendedSlotFunction, \
-  typename Mutex
+  typename Mutex, \
+  typename SlotStorage, \
+  typename Allocator, \
+  typename GarbageCollection
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_DEFAULTED_DECL(arity) \
   typename Signature, \
   typename Combiner = optional_last_value<typename boost::function_traits<Signature>::result_type>, \
@@ -186,7 +195,10 @@
   typename GroupCompare = std::less<Group>, \
   typename SlotFunction = boost::function<Signature>, \
   typename ExtendedSlotFunction = typename detail::variadic_extended_signature<Signature>::function_type, \
-  typename Mutex = signals2::mutex
+  typename Mutex = signals2::mutex, \
+  typename SlotStorage = signals2::vector_slot_storage, \
+  typename Allocator = std::allocator<void>, \
+  typename GarbageCollection = signals2::eager_garbage_collection
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_SPECIALIZATION_DECL(arity) \
   typename Combiner, \
   typename Group, \
@@ -194,6 +206,9 @@
   typename SlotFunction, \
   typename ExtendedSlotFunction, \
   typename Mutex, \
+  typename SlotStorage, \
+  typename Allocator, \
+  typename GarbageCollection, \
   typename R, \
   typename ... Args
 #define BOOST_SIGNALS2_SIGNAL_TEMPLATE_SPECIALIZATION <\
@@ -203,7 +218,10 @@
   GroupCompare, \
   SlotFunction, \
   ExtendedSlotFunction, \
-  Mutex>
+  Mutex, \
+  SlotStorage, \
+  Allocator, \
+  GarbageCollection>
 
 #define BOOST_SIGNALS2_STD_FUNCTIONAL_BASE \
   std_functional_base<Args...>
@@ -14,6 +14,7 @@
 
 #include <boost/assert.hpp>
 #include <boost/core/no_exceptions_support.hpp>
+#include <boost/core/noncopyable.hpp>
 #include <boost/iterator/iterator_facade.hpp>
 #include <boost/optional.hpp>
 #include <boost/scoped_ptr.hpp>
@@ -25,6 +26,7 @@
 #include <boost/type_traits/add_reference.hpp>
 #include <boost/type_traits/aligned_storage.hpp>
 #include <boost/weak_ptr.hpp>
+#include <iterator>
 
 namespace boost {
   namespace signals2 {
@@ -37,27 +39,24 @@ namespace boost {
           f(f_arg),
           connected_slot_count(0),
           disconnected_slot_count(0),
-          m_active_slot(0)
+          m_active_slot(0),
+          active_slot_connected(false)
         {}
 
         ~slot_call_iterator_cache()
         {
           if(m_active_slot)
           {
-            garbage_collecting_lock<connection_body_base> lock(*m_active_slot);
-            m_active_slot->dec_slot_refcount(lock);
+            m_active_slot->dec_slot_refcount();
           }
         }
 
-        template<typename M>
-        void set_active_slot(garbage_collecting_lock<M> &lock,
-          connection_body_base *active_slot)
+        // takes over a slot reference already held by the caller
+        void set_active_slot(connection_body_base *active_slot)
         {
           if(m_active_slot)
-            m_active_slot->dec_slot_refcount(lock);
+            m_active_slot->dec_slot_refcount();
           m_active_slot = active_slot;
-          if(m_active_slot)
-            m_active_slot->inc_slot_refcount(lock);
         }
 
         optional<ResultType> result;
@@ -67,6 +66,8 @@ namespace boost {
         unsigned connected_slot_count;
         unsigned disconnected_slot_count;
         connection_body_base *m_active_slot;
+        // which of the counts the active slot went into
+        bool active_slot_connected;
       };
 
       // Generates a slot call iterator. Essentially, this is an iterator that:
@@ -86,11 +87,12 @@ namespace boost {
 
         typedef typename Function::result_type result_type;
 
-        typedef slot_call_iterator_cache<result_type, Function> cache_type;
-
         friend class boost::iterator_core_access;
 
       public:
+        typedef slot_call_iterator_cache<result_type, Function> cache_type;
+        typedef Iterator base_type;
+
         slot_call_iterator_t(Iterator iter_in, Iterator end_in,
           cache_type &c):
           iter(iter_in), end(end_in),
@@ -99,6 +101,31 @@ namespace boost {
           lock_next_callable();
         }
 
+        /* For combiners which share the slots out between threads: the part
+        of the slot list not yet called, and the invocation's cache.  Each
+        share is called through iterators with a cache of its own, made from
+        this one's function, whose slot counts are added back here. */
+        Iterator base() const {return iter;}
+        Iterator base_end() const {return end;}
+        cache_type & invocation_cache() const {return *cache;}
+        /* Gives up the slot the iterator stands on, taking it back out of the
+        invocation's slot counts and dropping its reference and tracked
+        objects, so that the shares can start from base() without counting
+        or holding it twice.  The iterator isn't to be used afterwards. */
+        Iterator release() const
+        {
+          if(callable_iter != end)
+          {
+            if(cache->active_slot_connected)
+              --cache->connected_slot_count;
+            else
+              --cache->disconnected_slot_count;
+            cache->tracked_ptrs.clear();
+            set_callable_iter(end);
+          }
+          return iter;
+        }
+
         typename inherited::reference
         dereference() const
         {
@@ -132,13 +159,13 @@ namespace boost {
       private:
         typedef garbage_collecting_lock<connection_body_base> lock_type;
 
-        void set_callable_iter(lock_type &lock, Iterator newValue) const
+        void set_callable_iter(Iterator newValue) const
         {
           callable_iter = newValue;
           if(callable_iter == end)
-            cache->set_active_slot(lock, 0);
+            cache->set_active_slot(0);
           else
-            cache->set_active_slot(lock, (*callable_iter).get());
+            cache->set_active_slot((*callable_iter).get());
         }
 
         void lock_next_callable() const
@@ -150,29 +177,48 @@ namespace boost {
   
           for(;iter != end; ++iter)
           {
-            cache->tracked_ptrs.clear();
-            lock_type lock(**iter);
-            (*iter)->nolock_grab_tracked_objects(lock, std::back_inserter(cache->tracked_ptrs));
-            if((*iter)->nolock_nograb_connected())
+            // the reference keeps the slot alive while we look at it, so
+            // the connection only has to be locked if there are tracked
+            // objects to grab
+            connection_body_base::state_type state;
+            if((*iter)->try_inc_slot_refcount(state) == false)
+            {
+              ++cache->disconnected_slot_count;
+              continue;
+            }
+            // the objects locked for the previous slot are only released
+            // here, so a signal whose slots track nothing never touches them
+            if(cache->tracked_ptrs.empty() == false)
+              cache->tracked_ptrs.clear();
+            if(connection_body_base::has_tracked_objects(state))
+            {
+              cache->tracked_ptrs.reserve((*iter)->tracked_object_count());
+              lock_type lock(**iter);
+              (*iter)->nolock_grab_tracked_objects(lock, std::back_inserter(cache->tracked_ptrs));
+              state = (*iter)->nolock_nograb_state();
+            }
+            const bool connected = connection_body_base::is_connected(state);
+            if(connected)
             {
               ++cache->connected_slot_count;
             }else
             {
               ++cache->disconnected_slot_count;
             }
-            if((*iter)->nolock_nograb_blocked() == false)
+            if(connection_body_base::nolock_nograb_blocked(state) == false)
             {
-              set_callable_iter(lock, iter);
+              cache->active_slot_connected = connected;
+              set_callable_iter(iter);
               break;
             }
+            (*iter)->dec_slot_refcount();
           }
           
           if(iter == end)
           {
             if(callable_iter != end)
             {
-              lock_type lock(**callable_iter);
-              set_callable_iter(lock, end);
+              set_callable_iter(end);
             }
           }
         }
@@ -182,6 +228,219 @@ namespace boost {
         cache_type *cache;
         mutable Iterator callable_iter;
       };
+
+      // The slot counts and locked tracked objects of an emission which
+      // calls its slots directly, without a combiner
+      class direct_call_state: noncopyable
+      {
+      public:
+        direct_call_state(): connected_slot_count(0), disconnected_slot_count(0)
+        {}
+        unsigned connected_slot_count;
+        unsigned disconnected_slot_count;
+        auto_buffer<void_shared_ptr_variant, store_n_objects<10> > tracked_ptrs;
+      };
+
+      // drops a slot reference taken with try_inc_slot_refcount
+      class slot_reference: noncopyable
+      {
+      public:
+        explicit slot_reference(connection_body_base &body): _body(body)
+        {}
+        ~slot_reference()
+        {
+          _body.dec_slot_refcount();
+        }
+      private:
+        connection_body_base &_body;
+      };
+
+      /* Calls f on each connected, unblocked slot in [first, last), as a
+      combiner which dereferences every slot_call_iterator_t and ignores
+      expired_slot would, but in a single loop with no result caching.  The
+      tracked objects of the slot last called stay locked in state. */
+      template<typename Function, typename Iterator>
+      void call_slots_directly(const Function &f, Iterator first, Iterator last,
+        direct_call_state &state)
+      {
+        typedef garbage_collecting_lock<connection_body_base> lock_type;
+        for(; first != last; ++first)
+        {
+          connection_body_base::state_type body_state;
+          if((*first)->try_inc_slot_refcount(body_state) == false)
+          {
+            ++state.disconnected_slot_count;
+            continue;
+          }
+          slot_reference reference(**first);
+          if(state.tracked_ptrs.empty() == false)
+            state.tracked_ptrs.clear();
+          if(connection_body_base::has_tracked_objects(body_state))
+          {
+            state.tracked_ptrs.reserve((*first)->tracked_object_count());
+            lock_type lock(**first);
+            (*first)->nolock_grab_tracked_objects(lock, std::back_inserter(state.tracked_ptrs));
+            body_state = (*first)->nolock_nograb_state();
+          }
+          if(connection_body_base::is_connected(body_state))
+          {
+            ++state.connected_slot_count;
+          }else
+          {
+            ++state.disconnected_slot_count;
+          }
+          if(connection_body_base::nolock_nograb_blocked(body_state)) continue;
+          BOOST_TRY
+          {
+            f(*first);
+          }
+          BOOST_CATCH(expired_slot &)
+          {
+            (*first)->disconnect();
+          }
+          BOOST_CATCH_END
+        }
+      }
+
+      // The connected slots of a batched emission.  Each holds a slot
+      // reference, and has its tracked objects locked, until the whole
+      // batch has been emitted.
+      template<typename ConnectionBodyPtr>
+      class batch_slots: noncopyable
+      {
+        typedef garbage_collecting_lock<connection_body_base> lock_type;
+        typedef auto_buffer<const ConnectionBodyPtr *, store_n_objects<10> > slots_type;
+      public:
+        typedef typename slots_type::const_iterator const_iterator;
+
+        template<typename Iterator>
+        batch_slots(Iterator first, Iterator last):
+          connected_slot_count(0),
+          disconnected_slot_count(0)
+        {
+          for(; first != last; ++first)
+          {
+            // make room first, so nothing can throw while we hold a reference
+            _slots.reserve(_slots.size() + 1);
+            _tracked_ptrs.reserve(_tracked_ptrs.size() + (*first)->tracked_object_count());
+            connection_body_base::state_type state;
+            if((*first)->try_inc_slot_refcount(state) == false)
+            {
+              ++disconnected_slot_count;
+              continue;
+            }
+            if(connection_body_base::has_tracked_objects(state))
+            {
+              lock_type lock(**first);
+              (*first)->nolock_grab_tracked_objects(lock, std::back_inserter(_tracked_ptrs));
+              state = (*first)->nolock_nograb_state();
+            }
+            if(connection_body_base::is_connected(state) == false)
+            {
+              ++disconnected_slot_count;
+              (*first)->dec_slot_refcount();
+              continue;
+            }
+            ++connected_slot_count;
+            _slots.push_back(&*first);
+          }
+        }
+        ~batch_slots()
+        {
+          for(const_iterator it = _slots.begin(); it != _slots.end(); ++it)
+          {
+            (**it)->dec_slot_refcount();
+          }
+        }
+        const_iterator begin() const {return _slots.begin();}
+        const_iterator end() const {return _slots.end();}
+
+        unsigned connected_slot_count;
+        unsigned disconnected_slot_count;
+      private:
+        slots_type _slots;
+        auto_buffer<void_shared_ptr_variant, store_n_objects<10> > _tracked_ptrs;
+      };
+
+      template<typename ResultType, typename Function>
+      class batch_call_cache
+      {
+      public:
+        batch_call_cache(const Function &f_arg): f(f_arg)
+        {}
+
+        optional<ResultType> result;
+        Function f;
+      };
+
+      // Calls the slots of a batched emission with one set of arguments,
+      // skipping any which have been disconnected or blocked since the
+      // batch began.
+      template<typename Function, typename Iterator>
+      class batch_call_iterator_t
+        : public boost::iterator_facade<batch_call_iterator_t<Function, Iterator>,
+        typename Function::result_type,
+        boost::single_pass_traversal_tag>
+      {
+        typedef boost::iterator_facade<batch_call_iterator_t<Function, Iterator>,
+          typename Function::result_type,
+          boost::single_pass_traversal_tag>
+        inherited;
+
+        typedef typename Function::result_type result_type;
+
+        typedef batch_call_cache<result_type, Function> cache_type;
+
+        friend class boost::iterator_core_access;
+
+      public:
+        batch_call_iterator_t(Iterator iter_in, Iterator end_in, cache_type &c):
+          iter(iter_in), end(end_in), cache(&c)
+        {
+          skip_blocked();
+        }
+
+        typename inherited::reference
+        dereference() const
+        {
+          if (!cache->result) {
+            BOOST_TRY
+            {
+              cache->result = cache->f(**iter);
+            }
+            BOOST_CATCH(expired_slot &)
+            {
+              (**iter)->disconnect();
+              BOOST_RETHROW
+            }
+            BOOST_CATCH_END
+          }
+          return cache->result.get();
+        }
+
+        void increment()
+        {
+          ++iter;
+          skip_blocked();
+          cache->result.reset();
+        }
+
+        bool equal(const batch_call_iterator_t& other) const
+        {
+          return iter == other.iter;
+        }
+
+      private:
+        void skip_blocked()
+        {
+          while(iter != end && (**iter)->nolock_nograb_blocked())
+            ++iter;
+        }
+
+        Iterator iter;
+        Iterator end;
+        cache_type *cache;
+      };
     } // end namespace detail
   } // end namespace BOOST_SIGNALS_NAMESPACE
 } // end namespace boost
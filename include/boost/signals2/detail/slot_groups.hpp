@@ -11,20 +11,40 @@
 #ifndef BOOST_SIGNALS2_SLOT_GROUPS_HPP
 #define BOOST_SIGNALS2_SLOT_GROUPS_HPP
 
+#include <boost/core/allocator_access.hpp>
 #include <boost/signals2/connection.hpp>
 #include <boost/optional.hpp>
+#include <cstddef>
 #include <list>
 #include <map>
+#include <memory>
 #include <utility>
 
 namespace boost {
   namespace signals2 {
+    // Group type for signals whose slots are only ever connected at the
+    // front or back, which lets them drop all the group bookkeeping.
+    class no_groups {};
     namespace detail {
       enum slot_meta_group {front_ungrouped_slots, grouped_slots, back_ungrouped_slots};
       template<typename Group>
       struct group_key
       {
         typedef std::pair<enum slot_meta_group, boost::optional<Group> > type;
+        static type ungrouped(enum slot_meta_group meta_group)
+        {
+          return type(meta_group, boost::optional<Group>());
+        }
+      };
+      class no_group_key {};
+      template<>
+      struct group_key<no_groups>
+      {
+        typedef no_group_key type;
+        static type ungrouped(enum slot_meta_group)
+        {
+          return type();
+        }
       };
       template<typename Group, typename GroupCompare>
       class group_key_less
@@ -43,18 +63,34 @@ namespace boost {
       private:
         GroupCompare _group_compare;
       };
-      template<typename Group, typename GroupCompare, typename ValueType>
+      template<typename GroupCompare>
+      class group_key_less<no_groups, GroupCompare>
+      {
+      public:
+        group_key_less()
+        {}
+        group_key_less(const GroupCompare &)
+        {}
+        bool operator ()(const no_group_key &, const no_group_key &) const
+        {
+          return false;
+        }
+      };
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
       class grouped_list
       {
       public:
         typedef group_key_less<Group, GroupCompare> group_key_compare_type;
       private:
-        typedef std::list<ValueType> list_type;
+        typedef std::list<ValueType, typename boost::allocator_rebind<Allocator, ValueType>::type> list_type;
+        typedef std::pair<const typename group_key<Group>::type, typename list_type::iterator> map_value_type;
         typedef std::map
           <
             typename group_key<Group>::type,
             typename list_type::iterator,
-            group_key_compare_type
+            group_key_compare_type,
+            typename boost::allocator_rebind<Allocator, map_value_type>::type
           > map_type;
         typedef typename map_type::iterator map_iterator;
         typedef typename map_type::const_iterator const_map_iterator;
@@ -63,7 +99,10 @@ namespace boost {
         typedef typename list_type::const_iterator const_iterator;
         typedef typename group_key<Group>::type group_key_type;
 
-        grouped_list(const group_key_compare_type &group_key_compare):
+        grouped_list(const group_key_compare_type &group_key_compare,
+          const Allocator &allocator = Allocator()):
+          _list(typename list_type::allocator_type(allocator)),
+          _group_map(group_key_compare, typename map_type::allocator_type(allocator)),
           _group_key_compare(group_key_compare)
         {}
         grouped_list(const grouped_list &other): _list(other._list),
@@ -98,6 +137,10 @@ namespace boost {
         {
           return _list.end();
         }
+        std::size_t size() const
+        {
+          return _list.size();
+        }
         iterator lower_bound(const group_key_type &key)
         {
           map_iterator map_it = _group_map.lower_bound(key);
@@ -164,6 +207,21 @@ namespace boost {
           }
           return _list.erase(it);
         }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          iterator it = _list.begin();
+          while(it != _list.end())
+          {
+            if(pred(*it))
+            {
+              it = erase((*it)->group_key(), it);
+            }else
+            {
+              ++it;
+            }
+          }
+        }
         void clear()
         {
           _list.clear();
@@ -227,6 +285,64 @@ namespace boost {
         map_type _group_map;
         group_key_compare_type _group_key_compare;
       };
+      /* Without groups, slots are only ever added at either end of the list,
+      so there is no group map to maintain and connecting or erasing a slot
+      takes constant time. */
+      template<typename GroupCompare, typename ValueType, typename Allocator>
+      class grouped_list<no_groups, GroupCompare, ValueType, Allocator>
+      {
+      public:
+        typedef group_key_less<no_groups, GroupCompare> group_key_compare_type;
+      private:
+        typedef std::list<ValueType, typename boost::allocator_rebind<Allocator, ValueType>::type> list_type;
+      public:
+        typedef typename list_type::iterator iterator;
+        typedef typename list_type::const_iterator const_iterator;
+        typedef group_key<no_groups>::type group_key_type;
+
+        grouped_list(const group_key_compare_type &, const Allocator &allocator = Allocator()):
+          _list(typename list_type::allocator_type(allocator))
+        {}
+        iterator begin()
+        {
+          return _list.begin();
+        }
+        iterator end()
+        {
+          return _list.end();
+        }
+        std::size_t size() const
+        {
+          return _list.size();
+        }
+        void push_front(const group_key_type &, const ValueType &value)
+        {
+          _list.push_front(value);
+        }
+        void push_back(const group_key_type &, const ValueType &value)
+        {
+          _list.push_back(value);
+        }
+        iterator erase(const group_key_type &, const iterator &it)
+        {
+          BOOST_ASSERT(it != _list.end());
+          return _list.erase(it);
+        }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          _list.remove_if(pred);
+        }
+        void clear()
+        {
+          _list.clear();
+        }
+      private:
+        /* Suppress default assignment operator, like grouped_list. */
+        grouped_list& operator=(const grouped_list &other);
+
+        list_type _list;
+      };
     } // end namespace detail
     enum connect_position { at_back, at_front };
   } // end namespace signals2
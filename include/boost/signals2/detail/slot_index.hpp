@@ -0,0 +1,140 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_SLOT_INDEX_HPP
+#define BOOST_SIGNALS2_SLOT_INDEX_HPP
+
+#include <algorithm>
+#include <boost/config.hpp>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <vector>
+#ifdef BOOST_NO_CXX11_HDR_UNORDERED_MAP
+#include <map>
+#else
+#include <unordered_map>
+#endif
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      // how the target of a slot function relates to the slots indexed by a slot_index
+      enum slot_target_kind
+      {
+        // the slot can't hold a target of the indexed type
+        unrelated_target,
+        // the slot's target has the indexed type, and is filed under its hash
+        indexed_target,
+        // the slot wraps another slot function, which might hold one
+        wrapped_target
+      };
+
+      // function pointers can't portably be converted to integers, so this
+      // hashes their bytes instead (FNV-1a)
+      template<typename FunctionPointer>
+      std::size_t hash_function_pointer(const FunctionPointer &f)
+      {
+        unsigned char bytes[sizeof(FunctionPointer)];
+        std::memcpy(bytes, &f, sizeof(FunctionPointer));
+        std::size_t hash = 2166136261u;
+        for(std::size_t i = 0; i < sizeof(FunctionPointer); ++i)
+          hash = (hash ^ bytes[i]) * 16777619u;
+        return hash;
+      }
+
+      /* An index of a signal's connections by the value of their slot's
+      target, for targets of one function pointer type, so that disconnecting
+      by function pointer only has to check the connections which might hold
+      it.  The classifier decides where each connection goes.  Entries for
+      disconnected connections are left in place until prune() is called. */
+      template<typename ConnectionBody>
+      class slot_index
+      {
+#ifdef BOOST_NO_CXX11_HDR_UNORDERED_MAP
+        typedef std::multimap<std::size_t, ConnectionBody> target_map_type;
+#else
+        typedef std::unordered_multimap<std::size_t, ConnectionBody> target_map_type;
+#endif
+      public:
+        typedef slot_target_kind (*classifier_type)(const ConnectionBody &body, std::size_t &hash);
+        typedef typename target_map_type::const_iterator target_iterator;
+        typedef typename std::vector<ConnectionBody>::const_iterator wrapped_iterator;
+
+        explicit slot_index(classifier_type classifier): _classifier(classifier)
+        {}
+        classifier_type classifier() const {return _classifier;}
+        void add(const ConnectionBody &body)
+        {
+          std::size_t hash = 0;
+          switch(_classifier(body, hash))
+          {
+          case indexed_target:
+            _targets.insert(std::make_pair(hash, body));
+            break;
+          case wrapped_target:
+            _wrapped.push_back(body);
+            break;
+          case unrelated_target:
+            break;
+          }
+        }
+        // the indexed connections whose target has the given hash
+        std::pair<target_iterator, target_iterator> targets(std::size_t hash) const
+        {
+          return _targets.equal_range(hash);
+        }
+        wrapped_iterator wrapped_begin() const {return _wrapped.begin();}
+        wrapped_iterator wrapped_end() const {return _wrapped.end();}
+        std::size_t size() const {return _targets.size() + _wrapped.size();}
+        // removes the entries of disconnected connections with the given
+        // hash or a wrapped target, which are the ones looked at for it
+        void prune(std::size_t hash)
+        {
+          std::pair<typename target_map_type::iterator, typename target_map_type::iterator>
+            range = _targets.equal_range(hash);
+          while(range.first != range.second)
+          {
+            if(range.first->second->nolock_nograb_connected()) ++range.first;
+            else _targets.erase(range.first++);
+          }
+          prune_wrapped();
+        }
+        // removes the entries of connections which have been disconnected
+        void prune()
+        {
+          typename target_map_type::iterator it = _targets.begin();
+          while(it != _targets.end())
+          {
+            if(it->second->nolock_nograb_connected()) ++it;
+            else _targets.erase(it++);
+          }
+          prune_wrapped();
+        }
+      private:
+        void prune_wrapped()
+        {
+          _wrapped.erase(std::remove_if(_wrapped.begin(), _wrapped.end(), &disconnected),
+            _wrapped.end());
+        }
+        static bool disconnected(const ConnectionBody &body)
+        {
+          return body->nolock_nograb_connected() == false;
+        }
+
+        classifier_type _classifier;
+        target_map_type _targets;
+        std::vector<ConnectionBody> _wrapped;
+      };
+    } // namespace detail
+  } // namespace signals2
+} // namespace boost
+
+#endif // BOOST_SIGNALS2_SLOT_INDEX_HPP
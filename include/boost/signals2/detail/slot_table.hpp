@@ -0,0 +1,178 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_SLOT_TABLE_HPP
+#define BOOST_SIGNALS2_SLOT_TABLE_HPP
+
+#include <boost/assert.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/signals2/detail/atomic.hpp>
+#include <boost/throw_exception.hpp>
+#include <cstddef>
+#include <stdexcept>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      class connection_body_base;
+
+      /* The table of a signal's connections which have a connection_handle.
+      Each entry packs a generation and the connection's state into one
+      word, so a handle, which is an entry's index and the generation it was
+      given, can be checked without locking or touching the connection body.
+      Releasing an entry moves it to the next generation, which stales every
+      handle to it.  Entries are kept in segments of doubling size which are
+      never moved or freed while the table exists, so lookups may run
+      concurrently with the table growing.  Everything but find() and
+      disconnect() must be called with the signal's mutex locked. */
+      class slot_table: public noncopyable
+      {
+      public:
+        typedef boost::uint64_t state_type;
+        BOOST_STATIC_CONSTANT(state_type, connected_flag = 1u);
+        BOOST_STATIC_CONSTANT(state_type, tracked_flag = 2u);
+
+        class entry
+        {
+        public:
+          static boost::uint32_t generation(state_type state)
+          {
+            return static_cast<boost::uint32_t>(state >> 32);
+          }
+          atomic<state_type> state;
+          // guarded by the signal's mutex, and only valid while the entry is in use
+          connection_body_base *body;
+          // the index of the next free entry, while this one is free
+          boost::uint32_t next_free;
+        };
+
+        slot_table(): _size(0), _first_free(0)
+        {
+          for(std::size_t i = 0; i < max_segments; ++i)
+            _segments[i].store(0, memory_order_relaxed);
+        }
+        ~slot_table()
+        {
+          for(std::size_t i = 0; i < max_segments; ++i)
+            delete [] _segments[i].load(memory_order_relaxed);
+        }
+        // makes sure the next nolock_acquire() won't throw
+        void nolock_reserve()
+        {
+          if(_first_free != 0) return;
+          if(_size == max_size)
+            boost::throw_exception(std::length_error("boost::signals2::detail::slot_table"));
+          std::size_t segment, offset;
+          locate(_size, segment, offset);
+          // the segment may already have been made by an earlier reserve
+          if(offset != 0 || _segments[segment].load(memory_order_relaxed) != 0) return;
+          entry *entries = new entry[segment_size(segment)];
+          for(std::size_t i = 0; i < segment_size(segment); ++i)
+          {
+            entries[i].state.store(state_type(1) << 32, memory_order_relaxed);
+            entries[i].body = 0;
+            entries[i].next_free = 0;
+          }
+          _segments[segment].store(entries, memory_order_release);
+        }
+        // assigns body an entry, returning its index, which is never zero,
+        // and the entry's generation
+        boost::uint32_t nolock_acquire(connection_body_base *body, bool tracked,
+          boost::uint32_t &generation)
+        {
+          nolock_reserve();
+          boost::uint32_t index = _first_free;
+          entry *e;
+          if(index != 0)
+          {
+            e = find(index);
+            _first_free = e->next_free;
+          }else
+          {
+            index = static_cast<boost::uint32_t>(++_size);
+            e = find(index);
+          }
+          BOOST_ASSERT(e != 0);
+          const state_type state = e->state.load(memory_order_relaxed);
+          generation = entry::generation(state);
+          e->body = body;
+          e->state.store(state | connected_flag | (tracked ? tracked_flag : 0), memory_order_release);
+          return index;
+        }
+        // frees the entry of a connection which has been disconnected
+        void nolock_release(boost::uint32_t index)
+        {
+          entry *e = find(index);
+          BOOST_ASSERT(e != 0);
+          boost::uint32_t next_generation = entry::generation(e->state.load(memory_order_relaxed)) + 1;
+          // generation zero is never given out, so a zero handle is never valid
+          if(next_generation == 0) next_generation = 1;
+          e->body = 0;
+          e->state.store(state_type(next_generation) << 32, memory_order_release);
+          e->next_free = _first_free;
+          _first_free = index;
+        }
+        // clears the connected flag of an entry, unless it has moved on to
+        // another generation.  Lock-free.
+        void disconnect(boost::uint32_t index, boost::uint32_t generation)
+        {
+          entry *e = find(index);
+          BOOST_ASSERT(e != 0);
+          state_type state = e->state.load(memory_order_relaxed);
+          while(entry::generation(state) == generation && (state & connected_flag))
+          {
+            if(e->state.compare_exchange_weak(state, state & ~connected_flag,
+              memory_order_release, memory_order_relaxed))
+            {
+              return;
+            }
+          }
+        }
+        // the entry at index, or null if there is none.  Lock-free.
+        entry * find(boost::uint32_t index) const
+        {
+          if(index == 0) return 0;
+          std::size_t segment, offset;
+          locate(index - 1, segment, offset);
+          if(segment >= max_segments) return 0;
+          entry *entries = _segments[segment].load(memory_order_acquire);
+          if(entries == 0) return 0;
+          return &entries[offset];
+        }
+      private:
+        BOOST_STATIC_CONSTANT(std::size_t, first_segment_size = 64);
+        // enough segments for every index a 32-bit handle can hold
+        BOOST_STATIC_CONSTANT(std::size_t, max_segments = 26);
+        BOOST_STATIC_CONSTANT(std::size_t, max_size =
+          first_segment_size * ((std::size_t(1) << max_segments) - 1));
+
+        static std::size_t segment_size(std::size_t segment)
+        {
+          return first_segment_size << segment;
+        }
+        // segment k holds the 64 * 2^k entries after the 64 * (2^k - 1) before it
+        static void locate(std::size_t position, std::size_t &segment, std::size_t &offset)
+        {
+          std::size_t n = position / first_segment_size + 1;
+          segment = 0;
+          while(n >>= 1) ++segment;
+          offset = position - first_segment_size * ((std::size_t(1) << segment) - 1);
+        }
+
+        atomic<entry *> _segments[max_segments];
+        std::size_t _size;
+        boost::uint32_t _first_free;
+      };
+    } // namespace detail
+  } // namespace signals2
+} // namespace boost
+
+#endif // BOOST_SIGNALS2_SLOT_TABLE_HPP
@@ -0,0 +1,189 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_SMALL_VECTOR_HPP
+#define BOOST_SIGNALS2_SMALL_VECTOR_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      /* The subset of a vector used by the slot lists, keeping up to N
+      elements in a buffer inside the object itself.  Once it grows past N
+      every element moves to a heap allocated vector, so the elements are
+      always contiguous and indexing them never branches.  The elements move
+      back into the buffer once no more than N / 2 remain, and a copy with
+      no more than N elements never allocates. */
+      template<typename T, std::size_t N, typename Allocator = std::allocator<T> >
+      class small_vector
+      {
+        BOOST_STATIC_ASSERT(N > 0);
+        typedef std::vector<T, Allocator> heap_type;
+      public:
+        typedef T value_type;
+        typedef Allocator allocator_type;
+        typedef std::size_t size_type;
+        typedef T * iterator;
+        typedef const T * const_iterator;
+
+        explicit small_vector(const Allocator &allocator = Allocator()):
+          _heap(allocator), _data(buffer()), _size(0)
+        {}
+        small_vector(const small_vector &other):
+          _heap(other._heap.get_allocator()), _data(buffer()), _size(0)
+        {
+          if(other._size > N)
+          {
+            _heap.assign(other.begin(), other.end());
+            _data = &_heap.front();
+          }else
+          {
+            std::uninitialized_copy(other.begin(), other.end(), buffer());
+          }
+          _size = other._size;
+        }
+        ~small_vector()
+        {
+          if(spilled() == false) destroy_buffer(0);
+        }
+        iterator begin() {return _data;}
+        iterator end() {return _data + _size;}
+        const_iterator begin() const {return _data;}
+        const_iterator end() const {return _data + _size;}
+        size_type size() const {return _size;}
+        bool empty() const {return _size == 0;}
+        T & operator[](size_type position) {return _data[position];}
+        const T & operator[](size_type position) const {return _data[position];}
+
+        iterator insert(iterator where, const T &value)
+        {
+          const size_type position = where - _data;
+          BOOST_ASSERT(position <= _size);
+          if(spilled())
+          {
+            _heap.insert(_heap.begin() + position, value);
+            _data = &_heap.front();
+          }else if(_size == N)
+          {
+            spill(position, value);
+          }else
+          {
+            ::new(static_cast<void *>(buffer() + _size)) T(value);
+            ++_size;
+            std::rotate(buffer() + position, buffer() + _size - 1, buffer() + _size);
+            return _data + position;
+          }
+          _size = _heap.size();
+          return _data + position;
+        }
+        void push_back(const T &value)
+        {
+          insert(end(), value);
+        }
+        iterator erase(iterator first, iterator last)
+        {
+          const size_type position = first - _data;
+          const size_type count = last - first;
+          if(count == 0) return first;
+          if(spilled())
+          {
+            _heap.erase(_heap.begin() + position, _heap.begin() + position + count);
+            _size = _heap.size();
+            if(_size <= N / 2)
+              unspill();
+            else
+              _data = &_heap.front();
+          }else
+          {
+            std::copy(last, end(), first);
+            destroy_buffer(_size - count);
+          }
+          return _data + position;
+        }
+        iterator erase(iterator where)
+        {
+          return erase(where, where + 1);
+        }
+        void clear()
+        {
+          if(spilled())
+          {
+            heap_type empty(_heap.get_allocator());
+            _heap.swap(empty);
+            _data = buffer();
+            _size = 0;
+          }else
+          {
+            destroy_buffer(0);
+          }
+        }
+      private:
+        /* Suppress default assignment operator, like the slot lists. */
+        small_vector & operator=(const small_vector &other);
+
+        T * buffer()
+        {
+          return static_cast<T *>(static_cast<void *>(&_buffer));
+        }
+        const T * buffer() const
+        {
+          return static_cast<const T *>(static_cast<const void *>(&_buffer));
+        }
+        bool spilled() const {return _data != buffer();}
+        // destroys the elements of the buffer from position on
+        void destroy_buffer(size_type position)
+        {
+          while(_size > position)
+          {
+            --_size;
+            buffer()[_size].~T();
+          }
+        }
+        // moves the full buffer to the heap, inserting value at position
+        void spill(size_type position, const T &value)
+        {
+          heap_type heap(_heap.get_allocator());
+          heap.reserve(2 * N + 1);
+          heap.insert(heap.end(), buffer(), buffer() + position);
+          heap.push_back(value);
+          heap.insert(heap.end(), buffer() + position, buffer() + _size);
+          destroy_buffer(0);
+          _heap.swap(heap);
+          _data = &_heap.front();
+        }
+        // moves the few remaining elements back into the buffer, and frees the heap
+        void unspill()
+        {
+          BOOST_ASSERT(_size <= N);
+          std::uninitialized_copy(_heap.begin(), _heap.end(), buffer());
+          _data = buffer();
+          heap_type empty(_heap.get_allocator());
+          _heap.swap(empty);
+        }
+
+        typename boost::aligned_storage<sizeof(T) * N, boost::alignment_of<T>::value>::type _buffer;
+        heap_type _heap;
+        T *_data;
+        size_type _size;
+      };
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_SMALL_VECTOR_HPP
@@ -0,0 +1,164 @@
+// Boost.Signals2 library
+
+// Copyright The Boost.Signals2 contributors 2026
+// Use, modification and
+// distribution is subject to the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// For more information, see http://www.boost.org
+
+#ifndef BOOST_SIGNALS2_UNGROUPED_VECTOR_HPP
+#define BOOST_SIGNALS2_UNGROUPED_VECTOR_HPP
+
+#include <algorithm>
+#include <boost/assert.hpp>
+#include <boost/core/allocator_access.hpp>
+#include <boost/signals2/detail/grouped_vector.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+#include <memory>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      /* Slot list for signals which are not expected to use groups.  It is
+      a plain vector without any group index, so connecting an ungrouped
+      slot at the back is an amortized constant time append.  Grouped
+      slots still work and keep the same ordering as in grouped_list, but
+      their place in the vector is found by a binary search over the group
+      keys of the slots themselves, so ValueType must be a pointer to an
+      object with a group_key() method.  Vector may also be a small_vector,
+      for the slots to be kept inside the list itself while there are few. */
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType>,
+        typename Vector = std::vector<ValueType, typename boost::allocator_rebind<Allocator, ValueType>::type> >
+      class ungrouped_vector
+      {
+      public:
+        typedef group_key_less<Group, GroupCompare> group_key_compare_type;
+        typedef typename group_key<Group>::type group_key_type;
+      private:
+        typedef Vector vector_type;
+        typedef typename vector_type::size_type size_type;
+
+        class value_less
+        {
+        public:
+          value_less(const group_key_compare_type &group_key_compare):
+            _group_key_compare(group_key_compare)
+          {}
+          bool operator()(const ValueType &value, const group_key_type &key) const
+          {
+            return _group_key_compare(value->group_key(), key);
+          }
+          bool operator()(const group_key_type &key, const ValueType &value) const
+          {
+            return _group_key_compare(key, value->group_key());
+          }
+        private:
+          const group_key_compare_type &_group_key_compare;
+        };
+      public:
+        typedef vector_position_iterator<ValueType, vector_type> iterator;
+        typedef vector_position_iterator<const ValueType, const vector_type> const_iterator;
+
+        ungrouped_vector(const group_key_compare_type &group_key_compare,
+          const Allocator &allocator = Allocator()):
+          _vector(typename vector_type::allocator_type(allocator)),
+          _group_key_compare(group_key_compare)
+        {}
+        iterator begin()
+        {
+          return iterator(&_vector, 0);
+        }
+        iterator end()
+        {
+          return iterator(&_vector, _vector.size());
+        }
+        std::size_t size() const
+        {
+          return _vector.size();
+        }
+        iterator lower_bound(const group_key_type &key)
+        {
+          return iterator(&_vector, vector_lower_bound(key) - _vector.begin());
+        }
+        iterator upper_bound(const group_key_type &key)
+        {
+          return iterator(&_vector, vector_upper_bound(key) - _vector.begin());
+        }
+        void push_front(const group_key_type &key, const ValueType &value)
+        {
+          if(key.first == front_ungrouped_slots)
+          {// optimization
+            _vector.insert(_vector.begin(), value);
+          }else
+          {
+            _vector.insert(vector_lower_bound(key), value);
+          }
+        }
+        void push_back(const group_key_type &key, const ValueType &value)
+        {
+          if(key.first == back_ungrouped_slots)
+          {// optimization
+            _vector.push_back(value);
+          }else
+          {
+            _vector.insert(vector_upper_bound(key), value);
+          }
+        }
+        void erase(const group_key_type &key)
+        {
+          _vector.erase(vector_lower_bound(key), vector_upper_bound(key));
+        }
+        iterator erase(const group_key_type &, const iterator &it)
+        {
+          BOOST_ASSERT(it != end());
+          _vector.erase(_vector.begin() + it.position());
+          return it;
+        }
+        template<typename Predicate>
+        void remove_if(const Predicate &pred)
+        {
+          _vector.erase(_vector.begin() + compact_vector(_vector, 0, _vector.size(), 0, pred), _vector.end());
+        }
+        void clear()
+        {
+          _vector.clear();
+        }
+      private:
+        /* Suppress default assignment operator, like grouped_list. */
+        ungrouped_vector& operator=(const ungrouped_vector &other);
+
+        typename vector_type::iterator vector_lower_bound(const group_key_type &key)
+        {
+          return std::lower_bound(_vector.begin(), _vector.end(), key,
+            value_less(_group_key_compare));
+        }
+        typename vector_type::iterator vector_upper_bound(const group_key_type &key)
+        {
+          return std::upper_bound(_vector.begin(), _vector.end(), key,
+            value_less(_group_key_compare));
+        }
+
+        vector_type _vector;
+        group_key_compare_type _group_key_compare;
+      };
+      // without groups this is the same as grouped_vector, which keeps no index then
+      template<typename GroupCompare, typename ValueType, typename Allocator, typename Vector>
+      class ungrouped_vector<no_groups, GroupCompare, ValueType, Allocator, Vector>:
+        public grouped_vector<no_groups, GroupCompare, ValueType, Allocator, Vector>
+      {
+        typedef grouped_vector<no_groups, GroupCompare, ValueType, Allocator, Vector> base_type;
+      public:
+        ungrouped_vector(const typename base_type::group_key_compare_type &group_key_compare,
+          const Allocator &allocator = Allocator()):
+          base_type(group_key_compare, allocator)
+        {}
+      };
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_UNGROUPED_VECTOR_HPP
@@ -20,20 +20,27 @@ namespace boost
   {
     namespace detail
     {
+      struct try_to_lock_t {};
+
       template<typename Mutex>
       class unique_lock: public noncopyable
       {
       public:
-        unique_lock(Mutex &m): _mutex(m)
+        unique_lock(Mutex &m): _mutex(m), _owns(true)
         {
           _mutex.lock();
         }
+        unique_lock(Mutex &m, try_to_lock_t): _mutex(m), _owns(m.try_lock())
+        {
+        }
         ~unique_lock()
         {
-          _mutex.unlock();
+          if(_owns) _mutex.unlock();
         }
+        bool owns_lock() const {return _owns;}
       private:
         Mutex &_mutex;
+        bool _owns;
       };
     } // namespace detail
   } // namespace signals2
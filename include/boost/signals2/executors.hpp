@@ -0,0 +1,103 @@
+// Executors which run the tasks of asynchronous and parallel emission.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_EXECUTORS_HPP
+#define BOOST_SIGNALS2_EXECUTORS_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_HDR_THREAD) && \
+  !defined(BOOST_NO_CXX11_HDR_MUTEX) && !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+
+#include <boost/assert.hpp>
+#include <boost/core/noncopyable.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    // runs each task immediately on the thread which submits it
+    class inline_executor
+    {
+    public:
+      template<typename F>
+      void execute(F f) const
+      {
+        f();
+      }
+    };
+
+    // a fixed number of threads running tasks in the order they are submitted
+    class thread_pool_executor: noncopyable
+    {
+    public:
+      explicit thread_pool_executor(std::size_t num_threads = 1): _stopping(false)
+      {
+        BOOST_ASSERT(num_threads > 0);
+        for(std::size_t i = 0; i < num_threads; ++i)
+          _threads.push_back(std::thread(&thread_pool_executor::run, this));
+      }
+      // runs every task already submitted before joining the threads
+      ~thread_pool_executor()
+      {
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _stopping = true;
+        }
+        _task_available.notify_all();
+        for(std::size_t i = 0; i < _threads.size(); ++i)
+          _threads[i].join();
+      }
+      template<typename F>
+      void execute(F f)
+      {
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _tasks.push_back(std::function<void ()>(std::move(f)));
+        }
+        _task_available.notify_one();
+      }
+      std::size_t num_threads() const {return _threads.size();}
+    private:
+      void run()
+      {
+        for(;;)
+        {
+          std::function<void ()> task;
+          {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(_tasks.empty() && _stopping == false)
+              _task_available.wait(lock);
+            if(_tasks.empty()) return;
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+          }
+          task();
+        }
+      }
+
+      std::mutex _mutex;
+      std::condition_variable _task_available;
+      std::deque<std::function<void ()> > _tasks;
+      std::vector<std::thread> _threads;
+      bool _stopping;
+    };
+
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // C++11 threads
+
+#endif // BOOST_SIGNALS2_EXECUTORS_HPP
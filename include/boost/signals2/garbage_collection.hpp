@@ -0,0 +1,38 @@
+// Policies for when a signal removes disconnected slots from its slot
+// list, passed as the GarbageCollection template parameter of a signal.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_GARBAGE_COLLECTION_HPP
+#define BOOST_SIGNALS2_GARBAGE_COLLECTION_HPP
+
+#include <boost/config.hpp>
+
+namespace boost {
+  namespace signals2 {
+    // disconnected slots are removed a few at a time as the signal is
+    // invoked and connected to, with a full pass over the slot list when an
+    // invocation finds more disconnected slots than connected ones
+    class eager_garbage_collection
+    {
+    public:
+      BOOST_STATIC_CONSTANT(bool, deferred = false);
+    };
+    // invocations leave disconnected slots alone, for collect_garbage or a
+    // garbage_reaper to remove.  Connecting a slot still compacts the slot
+    // list once disconnected slots outnumber connected ones, so it stays
+    // bounded even if nothing else collects.
+    class deferred_garbage_collection
+    {
+    public:
+      BOOST_STATIC_CONSTANT(bool, deferred = true);
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_GARBAGE_COLLECTION_HPP
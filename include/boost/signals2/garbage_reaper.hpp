@@ -0,0 +1,148 @@
+// A thread which periodically removes disconnected slots from the slot
+// lists of the signals given to it.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_GARBAGE_REAPER_HPP
+#define BOOST_SIGNALS2_GARBAGE_REAPER_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_LAMBDAS) && \
+  !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) && \
+  !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+  !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+
+#include <boost/core/noncopyable.hpp>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    /* Calls collect_garbage(budget) on each signal added to it every interval,
+    from a thread of its own, so signals using deferred_garbage_collection
+    are compacted away from the threads which invoke them.  A reaper only
+    holds weak references to its signals, which it forgets once they have
+    been destroyed. */
+    class garbage_reaper: noncopyable
+    {
+    public:
+      explicit garbage_reaper(std::chrono::milliseconds interval = std::chrono::milliseconds(100),
+        std::size_t budget = 1024):
+        _interval(interval), _budget(budget), _stopping(false)
+      {
+        _thread = std::thread(&garbage_reaper::run, this);
+      }
+      ~garbage_reaper()
+      {
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          _stopping = true;
+        }
+        _stop.notify_all();
+        _thread.join();
+      }
+      template<typename Signal>
+      void add(const Signal &sig)
+      {
+        const typename Signal::weak_signal_type weak_sig(sig);
+        collector_type collector = [weak_sig](std::size_t budget, std::size_t &removed) -> bool
+        {
+          removed += weak_sig.collect_garbage(budget);
+          return weak_sig.expired() == false;
+        };
+        std::unique_lock<std::mutex> lock(_mutex);
+        _collectors.push_back(collector);
+      }
+      // collects from every signal on the calling thread, without waiting for
+      // the interval, and returns how many slots were removed
+      std::size_t collect()
+      {
+        std::unique_lock<std::mutex> round_lock(_round_mutex);
+        std::vector<collector_type> collectors;
+        {
+          std::unique_lock<std::mutex> lock(_mutex);
+          collectors.swap(_collectors);
+        }
+        std::size_t removed = 0;
+        std::size_t live = 0;
+        try
+        {
+          for(std::size_t i = 0; i < collectors.size(); ++i)
+          {
+            if(collectors[i](_budget, removed))
+              collectors[live++].swap(collectors[i]);
+          }
+        }
+        catch(...)
+        {
+          restore(collectors, collectors.size());
+          throw;
+        }
+        restore(collectors, live);
+        return removed;
+      }
+      // the number of signals added which had not been destroyed as of the last collection
+      std::size_t size() const
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        return _collectors.size();
+      }
+      std::chrono::milliseconds interval() const {return _interval;}
+      std::size_t budget() const {return _budget;}
+    private:
+      typedef std::function<bool (std::size_t, std::size_t &)> collector_type;
+
+      // puts the first count collectors back, ahead of any added during the collection
+      void restore(std::vector<collector_type> &collectors, std::size_t count)
+      {
+        collectors.resize(count);
+        std::unique_lock<std::mutex> lock(_mutex);
+        collectors.insert(collectors.end(), _collectors.begin(), _collectors.end());
+        collectors.swap(_collectors);
+      }
+      void run()
+      {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while(_stopping == false)
+        {
+          if(_stop.wait_for(lock, _interval) == std::cv_status::no_timeout) continue;
+          lock.unlock();
+          try
+          {
+            collect();
+          }
+          catch(...)
+          {
+            // a failed allocation is left for the next collection to retry
+          }
+          lock.lock();
+        }
+      }
+
+      const std::chrono::milliseconds _interval;
+      const std::size_t _budget;
+      mutable std::mutex _mutex;
+      // only one collection runs at a time
+      std::mutex _round_mutex;
+      std::condition_variable _stop;
+      std::vector<collector_type> _collectors;
+      bool _stopping;
+      std::thread _thread;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // C++11 threads
+
+#endif // BOOST_SIGNALS2_GARBAGE_REAPER_HPP
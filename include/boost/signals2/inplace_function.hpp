@@ -0,0 +1,280 @@
+// A function object wrapper which stores its target inside itself,
+// intended for use as the SlotFunction type of a signal.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_INPLACE_FUNCTION_HPP
+#define BOOST_SIGNALS2_INPLACE_FUNCTION_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+#include <boost/function/function_base.hpp>
+#include <boost/function_equal.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/throw_exception.hpp>
+#include <boost/type_index.hpp>
+#include <boost/type_traits/aligned_storage.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+namespace boost {
+  namespace signals2 {
+    template<typename Signature, std::size_t Capacity = 32,
+      std::size_t Alignment = boost::alignment_of<boost::detail::max_align>::value>
+    class inplace_function;
+
+    namespace detail {
+      // the operations inplace_function needs on its target, one table per target type
+      template<typename R, typename ... Args>
+      struct inplace_function_vtable
+      {
+        R (*invoke)(void *target, Args && ... args);
+        void (*copy)(void *destination, const void *source);
+        // move constructs at destination and destroys source
+        void (*relocate)(void *destination, void *source);
+        void (*destroy)(void *target);
+        const boost::typeindex::type_info & (*type)();
+      };
+
+      template<typename R, typename ... Args>
+      class empty_inplace_function
+      {
+      public:
+        static R invoke(void *, Args && ...)
+        {
+          boost::throw_exception(boost::bad_function_call());
+        }
+        static void copy(void *, const void *) {}
+        static void relocate(void *, void *) {}
+        static void destroy(void *) {}
+        static const boost::typeindex::type_info & type()
+        {
+          return boost::typeindex::type_id<void>().type_info();
+        }
+        static const inplace_function_vtable<R, Args...> vtable;
+      };
+      template<typename R, typename ... Args>
+      const inplace_function_vtable<R, Args...> empty_inplace_function<R, Args...>::vtable =
+      {
+        &empty_inplace_function::invoke,
+        &empty_inplace_function::copy,
+        &empty_inplace_function::relocate,
+        &empty_inplace_function::destroy,
+        &empty_inplace_function::type
+      };
+
+      template<typename F, typename R, typename ... Args>
+      class inplace_function_target
+      {
+      public:
+        static R invoke(void *target, Args && ... args)
+        {
+          return (*static_cast<F*>(target))(std::forward<Args>(args)...);
+        }
+        static void copy(void *destination, const void *source)
+        {
+          new(destination) F(*static_cast<const F*>(source));
+        }
+        static void relocate(void *destination, void *source)
+        {
+          new(destination) F(std::move(*static_cast<F*>(source)));
+          static_cast<F*>(source)->~F();
+        }
+        static void destroy(void *target)
+        {
+          static_cast<F*>(target)->~F();
+        }
+        static const boost::typeindex::type_info & type()
+        {
+          return boost::typeindex::type_id<F>().type_info();
+        }
+        static const inplace_function_vtable<R, Args...> vtable;
+      };
+      template<typename F, typename R, typename ... Args>
+      const inplace_function_vtable<R, Args...> inplace_function_target<F, R, Args...>::vtable =
+      {
+        &inplace_function_target::invoke,
+        &inplace_function_target::copy,
+        &inplace_function_target::relocate,
+        &inplace_function_target::destroy,
+        &inplace_function_target::type
+      };
+
+      // a null function pointer makes an empty inplace_function, like boost::function
+      template<typename F>
+      bool is_null_target(const F &f, typename enable_if<is_pointer<F> >::type * = 0)
+      {
+        return f == 0;
+      }
+      template<typename F>
+      bool is_null_target(const F &, typename disable_if<is_pointer<F> >::type * = 0)
+      {
+        return false;
+      }
+
+      template<typename T>
+      class is_inplace_function
+      {
+      public:
+        BOOST_STATIC_CONSTANT(bool, value = false);
+      };
+      template<typename Signature, std::size_t Capacity, std::size_t Alignment>
+      class is_inplace_function<inplace_function<Signature, Capacity, Alignment> >
+      {
+      public:
+        BOOST_STATIC_CONSTANT(bool, value = true);
+      };
+    } // namespace detail
+
+    /* Like boost::function, but the target is always stored in a buffer of
+    Capacity bytes inside the inplace_function itself rather than on the heap.
+    Trying to store a target which is too large or too strictly aligned for the
+    buffer fails to compile.  Invoking it is a single indirect call.  Like
+    boost::function, it knows the type of its target through Boost.TypeIndex,
+    for target() and contains(). */
+    template<typename R, typename ... Args, std::size_t Capacity, std::size_t Alignment>
+    class inplace_function<R (Args...), Capacity, Alignment>
+    {
+      typedef detail::inplace_function_vtable<R, Args...> vtable_type;
+      typedef detail::empty_inplace_function<R, Args...> empty_type;
+    public:
+      typedef R result_type;
+      BOOST_STATIC_CONSTANT(std::size_t, capacity = Capacity);
+
+      inplace_function() BOOST_NOEXCEPT: _vtable(&empty_type::vtable)
+      {}
+      template<typename F, typename = typename disable_if<
+        detail::is_inplace_function<typename decay<F>::type> >::type>
+      inplace_function(F && f): _vtable(&empty_type::vtable)
+      {
+        assign(std::forward<F>(f));
+      }
+      inplace_function(const inplace_function &other): _vtable(other._vtable)
+      {
+        _vtable->copy(&_buffer, &other._buffer);
+      }
+      inplace_function(inplace_function && other): _vtable(other._vtable)
+      {
+        _vtable->relocate(&_buffer, &other._buffer);
+        other._vtable = &empty_type::vtable;
+      }
+      ~inplace_function()
+      {
+        _vtable->destroy(&_buffer);
+      }
+      inplace_function & operator=(const inplace_function &other)
+      {
+        if(&other == this) return *this;
+        clear();
+        other._vtable->copy(&_buffer, &other._buffer);
+        _vtable = other._vtable;
+        return *this;
+      }
+      inplace_function & operator=(inplace_function && other)
+      {
+        if(&other == this) return *this;
+        clear();
+        other._vtable->relocate(&_buffer, &other._buffer);
+        _vtable = other._vtable;
+        other._vtable = &empty_type::vtable;
+        return *this;
+      }
+      template<typename F>
+      typename disable_if<detail::is_inplace_function<typename decay<F>::type>, inplace_function &>::type
+        operator=(F && f)
+      {
+        clear();
+        assign(std::forward<F>(f));
+        return *this;
+      }
+      void swap(inplace_function &other)
+      {
+        inplace_function temp(std::move(other));
+        other = std::move(*this);
+        *this = std::move(temp);
+      }
+      R operator()(Args ... args) const
+      {
+        return _vtable->invoke(const_cast<void*>(static_cast<const void*>(&_buffer)),
+          std::forward<Args>(args)...);
+      }
+      bool empty() const BOOST_NOEXCEPT
+      {
+        return _vtable == &empty_type::vtable;
+      }
+      void clear() BOOST_NOEXCEPT
+      {
+        _vtable->destroy(&_buffer);
+        _vtable = &empty_type::vtable;
+      }
+      explicit operator bool() const BOOST_NOEXCEPT
+      {
+        return !empty();
+      }
+      const boost::typeindex::type_info & target_type() const BOOST_NOEXCEPT
+      {
+        return _vtable->type();
+      }
+      template<typename F>
+      F * target() BOOST_NOEXCEPT
+      {
+        if(boost::typeindex::type_id<F>() != _vtable->type()) return 0;
+        return static_cast<F*>(static_cast<void*>(&_buffer));
+      }
+      template<typename F>
+      const F * target() const BOOST_NOEXCEPT
+      {
+        if(boost::typeindex::type_id<F>() != _vtable->type()) return 0;
+        return static_cast<const F*>(static_cast<const void*>(&_buffer));
+      }
+      template<typename F>
+      bool contains(const F &f) const
+      {
+        if(const F *fp = target<F>())
+          return function_equal(*fp, f);
+        return false;
+      }
+    private:
+      template<typename F>
+      void assign(F && f)
+      {
+        typedef typename decay<F>::type target_type;
+        BOOST_STATIC_ASSERT_MSG(sizeof(target_type) <= Capacity,
+          "target does not fit in the inplace_function, increase its Capacity");
+        BOOST_STATIC_ASSERT_MSG(Alignment % boost::alignment_of<target_type>::value == 0,
+          "target is too strictly aligned for the inplace_function");
+        if(detail::is_null_target(f)) return;
+        new(&_buffer) target_type(std::forward<F>(f));
+        _vtable = &detail::inplace_function_target<target_type, R, Args...>::vtable;
+      }
+
+      const vtable_type *_vtable;
+      typename aligned_storage<Capacity, Alignment>::type _buffer;
+    };
+
+    template<typename Signature, std::size_t Capacity, std::size_t Alignment>
+    void swap(inplace_function<Signature, Capacity, Alignment> &f1,
+      inplace_function<Signature, Capacity, Alignment> &f2)
+    {
+      f1.swap(f2);
+    }
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+
+#endif // BOOST_SIGNALS2_INPLACE_FUNCTION_HPP
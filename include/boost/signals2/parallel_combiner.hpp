@@ -0,0 +1,251 @@
+// A combiner which calls a signal's slots on several threads at once,
+// then hands their results to another combiner.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_PARALLEL_COMBINER_HPP
+#define BOOST_SIGNALS2_PARALLEL_COMBINER_HPP
+
+#include <boost/config.hpp>
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_LAMBDAS) && \
+  !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) && \
+  !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+  !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+
+#include <boost/core/noncopyable.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/slot_call_iterator.hpp>
+#include <boost/signals2/executors.hpp>
+#include <boost/signals2/expired_slot.hpp>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      /* One invocation of a parallel_combiner.  The slot list is cut into
+      chunks, which the emitting thread and the executor's tasks claim one at
+      a time until none are left, so threads which finish early take on more.
+      Tasks keep it alive, since one may only start after the invocation has
+      finished, in which case it finds nothing left to claim. */
+      template<typename SlotCallIterator>
+      class parallel_invocation: noncopyable
+      {
+      public:
+        typedef typename SlotCallIterator::cache_type cache_type;
+        typedef typename SlotCallIterator::base_type base_type;
+        typedef typename std::iterator_traits<SlotCallIterator>::value_type value_type;
+
+        // bounds holds the first slot of each chunk, then the end of the last
+        parallel_invocation(cache_type &invocation_cache, std::vector<base_type> &bounds):
+          _invocation_cache(invocation_cache),
+          _num_chunks(bounds.size() - 1),
+          _results(_num_chunks),
+          _slot_counts(_num_chunks),
+          _next_chunk(0),
+          _failed(false),
+          _chunks_done(0)
+        {
+          _bounds.swap(bounds);
+        }
+        // calls chunks until every one has been claimed
+        void work()
+        {
+          for(;;)
+          {
+            const std::size_t chunk = _next_chunk.fetch_add(1);
+            if(chunk >= _num_chunks) return;
+            // once a slot has thrown, the remaining chunks are only counted off
+            if(_failed.load() == false)
+            {
+              try
+              {
+                call_chunk(chunk);
+              }
+              catch(...)
+              {
+                std::unique_lock<std::mutex> lock(_mutex);
+                if(!_exception) _exception = std::current_exception();
+                _failed.store(true);
+              }
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            if(++_chunks_done == _num_chunks) _all_done.notify_all();
+          }
+        }
+        // waits for every chunk, then collects their results in slot order
+        void wait(std::vector<value_type> &results)
+        {
+          {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while(_chunks_done < _num_chunks)
+              _all_done.wait(lock);
+          }
+          if(_exception) std::rethrow_exception(_exception);
+          std::size_t size = 0;
+          for(std::size_t i = 0; i < _num_chunks; ++i)
+          {
+            size += _results[i].size();
+            // lets the signal decide whether its slot list needs cleaning up
+            _invocation_cache.connected_slot_count += _slot_counts[i].first;
+            _invocation_cache.disconnected_slot_count += _slot_counts[i].second;
+          }
+          results.reserve(size);
+          for(std::size_t i = 0; i < _num_chunks; ++i)
+            results.insert(results.end(), _results[i].begin(), _results[i].end());
+        }
+      private:
+        void call_chunk(std::size_t chunk)
+        {
+          // slot_call_iterator_t does the tracked object locking and blocking
+          // checks, through a cache of this thread's own
+          cache_type cache(_invocation_cache.f);
+          SlotCallIterator it(_bounds[chunk], _bounds[chunk + 1], cache);
+          const SlotCallIterator end(_bounds[chunk + 1], _bounds[chunk + 1], cache);
+          for(; it != end; ++it)
+          {
+            try
+            {
+              _results[chunk].push_back(*it);
+            }
+            catch(const expired_slot &)
+            {}
+          }
+          _slot_counts[chunk].first = cache.connected_slot_count;
+          _slot_counts[chunk].second = cache.disconnected_slot_count;
+        }
+
+        cache_type &_invocation_cache;
+        std::vector<base_type> _bounds;
+        const std::size_t _num_chunks;
+        std::vector<std::vector<value_type> > _results;
+        std::vector<std::pair<unsigned, unsigned> > _slot_counts;
+        std::atomic<std::size_t> _next_chunk;
+        std::atomic<bool> _failed;
+        std::mutex _mutex;
+        std::condition_variable _all_done;
+        std::size_t _chunks_done;
+        std::exception_ptr _exception;
+      };
+    } // namespace detail
+
+    /* Calls a signal's slots on up to num_threads threads at once: the
+    emitting thread, and tasks given to an executor.  Slots are called in
+    chunks of at least min_chunk_size consecutive slots, and every slot is
+    called before the results are passed, in slot order, to the inner
+    combiner.  Slots must be safe to call concurrently with each other. */
+    template<typename InnerCombiner>
+    class parallel_combiner
+    {
+    public:
+      typedef typename InnerCombiner::result_type result_type;
+      typedef InnerCombiner inner_combiner_type;
+
+      // shares the slots with a thread_pool_executor of num_threads - 1 threads
+      explicit parallel_combiner(std::size_t num_threads = default_num_threads(),
+        const inner_combiner_type &inner = inner_combiner_type(), std::size_t min_chunk_size = 1):
+        _inner(inner), _num_threads(num_threads), _min_chunk_size(min_chunk_size)
+      {
+        if(num_threads > 1)
+        {
+          boost::shared_ptr<thread_pool_executor> pool =
+            boost::make_shared<thread_pool_executor>(num_threads - 1);
+          _submit = [pool](std::function<void ()> task) {pool->execute(std::move(task));};
+        }
+      }
+      // shares the slots with tasks given to an executor of your own
+      template<typename Executor>
+      parallel_combiner(const boost::shared_ptr<Executor> &executor, std::size_t num_threads,
+        const inner_combiner_type &inner = inner_combiner_type(), std::size_t min_chunk_size = 1):
+        _submit([executor](std::function<void ()> task) {executor->execute(std::move(task));}),
+        _inner(inner), _num_threads(num_threads), _min_chunk_size(min_chunk_size)
+      {}
+
+      template<typename Function, typename Iterator, typename ConnectionBody>
+      result_type operator()(detail::slot_call_iterator_t<Function, Iterator, ConnectionBody> first,
+        detail::slot_call_iterator_t<Function, Iterator, ConnectionBody> last)
+      {
+        typedef detail::slot_call_iterator_t<Function, Iterator, ConnectionBody> slot_call_iterator;
+        typedef detail::parallel_invocation<slot_call_iterator> invocation_type;
+
+        if(_num_threads <= 1 || !_submit) return _inner(first, last);
+        const std::size_t num_slots = std::distance(first.base(), first.base_end());
+        // a few chunks per thread, so threads held up by slow slots don't
+        // hold up the whole invocation
+        std::size_t chunk_size = (num_slots + 4 * _num_threads - 1) / (4 * _num_threads);
+        if(chunk_size < _min_chunk_size) chunk_size = _min_chunk_size;
+        if(num_slots <= chunk_size) return _inner(first, last);
+
+        std::vector<Iterator> bounds;
+        // first has already counted and locked the slot it stands on, which
+        // the first chunk will call
+        Iterator it = first.release();
+        for(std::size_t i = 0; i < num_slots; ++i, ++it)
+        {
+          if(i % chunk_size == 0) bounds.push_back(it);
+        }
+        bounds.push_back(first.base_end());
+        boost::shared_ptr<invocation_type> invocation =
+          boost::make_shared<invocation_type>(first.invocation_cache(), bounds);
+        const std::size_t num_chunks = bounds.size() - 1;
+        const std::size_t num_tasks = std::min(_num_threads - 1, num_chunks - 1);
+        for(std::size_t i = 0; i < num_tasks; ++i)
+        {
+          try
+          {
+            _submit([invocation]() {invocation->work();});
+          }
+          catch(...)
+          {
+            // the emitting thread can call all of the chunks itself
+            break;
+          }
+        }
+        invocation->work();
+        std::vector<typename invocation_type::value_type> results;
+        invocation->wait(results);
+        return _inner(results.begin(), results.end());
+      }
+      // for invocations which can't be shared out, such as emit_batch
+      template<typename InputIterator>
+      result_type operator()(InputIterator first, InputIterator last)
+      {
+        return _inner(first, last);
+      }
+
+      const inner_combiner_type & inner_combiner() const {return _inner;}
+      std::size_t num_threads() const {return _num_threads;}
+    private:
+      static std::size_t default_num_threads()
+      {
+        const std::size_t hardware_threads = std::thread::hardware_concurrency();
+        return hardware_threads > 0 ? hardware_threads : 1;
+      }
+
+      std::function<void (std::function<void ()>)> _submit;
+      inner_combiner_type _inner;
+      std::size_t _num_threads;
+      std::size_t _min_chunk_size;
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // C++11 threads
+
+#endif // BOOST_SIGNALS2_PARALLEL_COMBINER_HPP
@@ -0,0 +1,303 @@
+// An allocator which recycles fixed size nodes through per-thread caches,
+// intended for use as the Allocator template parameter of a signal.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_POOL_ALLOCATOR_HPP
+#define BOOST_SIGNALS2_POOL_ALLOCATOR_HPP
+
+#include <boost/config.hpp>
+#include <boost/signals2/detail/unique_lock.hpp>
+#include <boost/signals2/mutex.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/alignment_of.hpp>
+#include <boost/type_traits/type_with_alignment.hpp>
+#include <cstddef>
+#include <limits>
+#include <new>
+
+namespace boost {
+  namespace signals2 {
+    namespace detail {
+      class pool_node
+      {
+      public:
+        pool_node *next;
+      };
+
+      // free nodes of a single size shared by all threads, refilled a chunk
+      // at a time.  Chunks are never returned to the system.
+      template<std::size_t NodeSize>
+      class global_node_pool
+      {
+      public:
+        BOOST_STATIC_CONSTANT(std::size_t, chunk_nodes = 64);
+
+        global_node_pool(): _free(0)
+        {}
+        static global_node_pool & instance()
+        {
+          // leaked so that thread caches can still be flushed into it during exit
+          static global_node_pool *pool = new global_node_pool();
+          return *pool;
+        }
+        // removes up to max_count nodes, linked through next, and returns the count
+        std::size_t take(pool_node *&first, std::size_t max_count)
+        {
+          unique_lock<mutex> lock(_mutex);
+          if(_free == 0) refill();
+          first = _free;
+          pool_node *last = _free;
+          std::size_t count = 1;
+          while(count < max_count && last->next != 0)
+          {
+            last = last->next;
+            ++count;
+          }
+          _free = last->next;
+          last->next = 0;
+          return count;
+        }
+        void give(pool_node *first, pool_node *last)
+        {
+          unique_lock<mutex> lock(_mutex);
+          last->next = _free;
+          _free = first;
+        }
+      private:
+        void refill()
+        {
+          char *chunk = static_cast<char*>(::operator new(NodeSize * chunk_nodes));
+          for(std::size_t i = 0; i < chunk_nodes; ++i)
+          {
+            pool_node *node = reinterpret_cast<pool_node*>(chunk + i * NodeSize);
+            node->next = i + 1 < chunk_nodes ? reinterpret_cast<pool_node*>(chunk + (i + 1) * NodeSize) : 0;
+          }
+          _free = reinterpret_cast<pool_node*>(chunk);
+        }
+
+        mutex _mutex;
+        pool_node *_free;
+      };
+
+      // single nodes straight from the global pool, taking its lock
+      template<std::size_t NodeSize>
+      void * allocate_global_pool_node()
+      {
+        pool_node *node;
+        global_node_pool<NodeSize>::instance().take(node, 1);
+        return node;
+      }
+      template<std::size_t NodeSize>
+      void deallocate_global_pool_node(void *p)
+      {
+        pool_node *node = static_cast<pool_node*>(p);
+        global_node_pool<NodeSize>::instance().give(node, node);
+      }
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+      // a thread's private free list in front of the global pool, so
+      // allocating and freeing nodes usually takes no lock
+      template<std::size_t NodeSize>
+      class thread_node_cache
+      {
+      public:
+        BOOST_STATIC_CONSTANT(std::size_t, max_nodes = 256);
+        BOOST_STATIC_CONSTANT(std::size_t, refill_nodes = 32);
+
+        thread_node_cache(): _free(0), _count(0)
+        {}
+        ~thread_node_cache()
+        {
+          if(_free != 0) release(_count);
+          destroyed() = true;
+        }
+        // the calling thread's cache, or null once it has been destroyed
+        // during the thread's exit, when other thread_local or static
+        // objects may still be freeing nodes
+        static thread_node_cache * instance()
+        {
+          if(destroyed()) return 0;
+          static thread_local thread_node_cache cache;
+          return &cache;
+        }
+        void * allocate()
+        {
+          if(_free == 0)
+            _count = global_node_pool<NodeSize>::instance().take(_free, refill_nodes);
+          pool_node *node = _free;
+          _free = node->next;
+          --_count;
+          return node;
+        }
+        void deallocate(void *p)
+        {
+          pool_node *node = static_cast<pool_node*>(p);
+          node->next = _free;
+          _free = node;
+          // hand half back once full, so a thread which only frees
+          // doesn't hold on to every node it ever saw
+          if(++_count > max_nodes) release(_count / 2);
+        }
+      private:
+        void release(std::size_t count)
+        {
+          pool_node *first = _free;
+          pool_node *last = _free;
+          for(std::size_t i = 1; i < count; ++i)
+            last = last->next;
+          _free = last->next;
+          _count -= count;
+          global_node_pool<NodeSize>::instance().give(first, last);
+        }
+
+        // trivially destructible, so it can still be read after the cache is gone
+        static bool & destroyed()
+        {
+          static thread_local bool flag = false;
+          return flag;
+        }
+
+        pool_node *_free;
+        std::size_t _count;
+      };
+
+      template<std::size_t NodeSize>
+      void * allocate_pool_node()
+      {
+        thread_node_cache<NodeSize> *cache = thread_node_cache<NodeSize>::instance();
+        if(cache == 0) return allocate_global_pool_node<NodeSize>();
+        return cache->allocate();
+      }
+      template<std::size_t NodeSize>
+      void deallocate_pool_node(void *p)
+      {
+        thread_node_cache<NodeSize> *cache = thread_node_cache<NodeSize>::instance();
+        if(cache == 0) return deallocate_global_pool_node<NodeSize>(p);
+        cache->deallocate(p);
+      }
+#else // BOOST_NO_CXX11_THREAD_LOCAL
+      template<std::size_t NodeSize>
+      void * allocate_pool_node()
+      {
+        return allocate_global_pool_node<NodeSize>();
+      }
+      template<std::size_t NodeSize>
+      void deallocate_pool_node(void *p)
+      {
+        deallocate_global_pool_node<NodeSize>(p);
+      }
+#endif // BOOST_NO_CXX11_THREAD_LOCAL
+
+      // objects of similar size share a pool, rounded up to the maximum alignment
+      template<typename T>
+      class pool_node_size
+      {
+        BOOST_STATIC_CONSTANT(std::size_t, alignment = boost::alignment_of<boost::detail::max_align>::value);
+      public:
+        BOOST_STATIC_CONSTANT(std::size_t, value = (sizeof(T) + alignment - 1) / alignment * alignment);
+        // larger objects are rare enough to just go to operator new
+        BOOST_STATIC_CONSTANT(bool, pooled = value <= 512);
+      };
+    } // namespace detail
+
+    /* A stateless allocator which serves single objects from per-size free
+    lists.  Freed nodes go to a small cache owned by the freeing thread and
+    are reused by the next allocation of that size on the same thread, so
+    connecting and disconnecting slots doesn't contend on the global heap.
+    Memory is only ever recycled, never returned to the system.  Arrays and
+    objects larger than 512 bytes are passed straight to operator new. */
+    template<typename T>
+    class pool_allocator
+    {
+    public:
+      typedef T value_type;
+      typedef T * pointer;
+      typedef const T * const_pointer;
+      typedef T & reference;
+      typedef const T & const_reference;
+      typedef std::size_t size_type;
+      typedef std::ptrdiff_t difference_type;
+      template<typename U> class rebind
+      {
+      public:
+        typedef pool_allocator<U> other;
+      };
+
+      pool_allocator() BOOST_NOEXCEPT
+      {}
+      template<typename U>
+      pool_allocator(const pool_allocator<U> &) BOOST_NOEXCEPT
+      {}
+
+      pointer allocate(size_type n, const void * = 0)
+      {
+        BOOST_STATIC_ASSERT_MSG(boost::alignment_of<T>::value <=
+          boost::alignment_of<boost::detail::max_align>::value,
+          "pool_allocator does not support over-aligned types");
+        if(n == 1 && detail::pool_node_size<T>::pooled)
+          return static_cast<pointer>(detail::allocate_pool_node<detail::pool_node_size<T>::value>());
+        return static_cast<pointer>(::operator new(n * sizeof(T)));
+      }
+      void deallocate(pointer p, size_type n)
+      {
+        if(n == 1 && detail::pool_node_size<T>::pooled)
+          detail::deallocate_pool_node<detail::pool_node_size<T>::value>(p);
+        else
+          ::operator delete(p);
+      }
+      size_type max_size() const BOOST_NOEXCEPT
+      {
+        return (std::numeric_limits<size_type>::max)() / sizeof(T);
+      }
+      pointer address(reference x) const {return &x;}
+      const_pointer address(const_reference x) const {return &x;}
+      void construct(pointer p, const T &value)
+      {
+        new(p) T(value);
+      }
+      void destroy(pointer p)
+      {
+        p->~T();
+      }
+    };
+
+    template<>
+    class pool_allocator<void>
+    {
+    public:
+      typedef void value_type;
+      typedef void * pointer;
+      typedef const void * const_pointer;
+      template<typename U> class rebind
+      {
+      public:
+        typedef pool_allocator<U> other;
+      };
+
+      pool_allocator() BOOST_NOEXCEPT
+      {}
+      template<typename U>
+      pool_allocator(const pool_allocator<U> &) BOOST_NOEXCEPT
+      {}
+    };
+
+    template<typename T, typename U>
+    bool operator==(const pool_allocator<T> &, const pool_allocator<U> &) BOOST_NOEXCEPT
+    {
+      return true;
+    }
+    template<typename T, typename U>
+    bool operator!=(const pool_allocator<T> &, const pool_allocator<U> &) BOOST_NOEXCEPT
+    {
+      return false;
+    }
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_POOL_ALLOCATOR_HPP
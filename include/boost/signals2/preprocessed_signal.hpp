@@ -24,8 +24,10 @@
 #include <boost/preprocessor/repetition.hpp>
 #include <boost/signals2/detail/preprocessed_arg_type.hpp>
 #include <boost/smart_ptr/make_shared.hpp>
+#include <boost/tuple/tuple.hpp>
 #include <boost/type_traits/add_reference.hpp>
 #include <boost/type_traits/is_void.hpp> 
+#include <memory>
 
 #define BOOST_PP_ITERATION_LIMITS (0, BOOST_SIGNALS2_MAX_ARGS)
 #define BOOST_PP_FILENAME_1 <boost/signals2/detail/signal_template.hpp>
@@ -41,16 +43,20 @@ namespace boost
       typename GroupCompare = std::less<Group>,
       typename SlotFunction = function<Signature>,
       typename ExtendedSlotFunction = typename detail::extended_signature<function_traits<Signature>::arity, Signature>::function_type,
-      typename Mutex = mutex >
+      typename Mutex = mutex,
+      typename SlotStorage = vector_slot_storage,
+      typename Allocator = std::allocator<void>,
+      typename GarbageCollection = eager_garbage_collection>
     class signal: public detail::signalN<function_traits<Signature>::arity,
-      Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex>::type
+      Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection>::type
     {
     private:
       typedef typename detail::signalN<boost::function_traits<Signature>::arity,
-        Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex>::type base_type;
+        Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection>::type base_type;
     public:
-      signal(const Combiner &combiner_arg = Combiner(), const GroupCompare &group_compare = GroupCompare()):
-        base_type(combiner_arg, group_compare)
+      signal(const Combiner &combiner_arg = Combiner(), const GroupCompare &group_compare = GroupCompare(),
+        const Allocator &alloc = Allocator()):
+        base_type(combiner_arg, group_compare, alloc)
       {}
 #if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && BOOST_WORKAROUND(BOOST_MSVC, < 1800)
       signal(signal && other) BOOST_NOEXCEPT: base_type(std::move(other)) {}
@@ -0,0 +1,36 @@
+// A model of the Lockable concept which, when used as the Mutex template
+// parameter of a signal, makes signal invocation obtain the signal's
+// slot list without locking.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_RCU_MUTEX_HPP
+#define BOOST_SIGNALS2_RCU_MUTEX_HPP
+
+#include <boost/mpl/bool.hpp>
+#include <boost/signals2/mutex.hpp>
+
+namespace boost {
+  namespace signals2 {
+    template<typename Mutex = mutex>
+    class rcu_mutex: public Mutex
+    {};
+
+    namespace detail
+    {
+      template<typename Mutex>
+      class is_rcu_mutex: public mpl::false_
+      {};
+      template<typename Mutex>
+      class is_rcu_mutex<rcu_mutex<Mutex> >: public mpl::true_
+      {};
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_RCU_MUTEX_HPP
@@ -39,7 +39,7 @@ namespace boost
           _blocker.reset(static_cast<int*>(0));
           return;
         }
-        _blocker = connection_body->get_blocker();
+        _blocker = connection_body->get_blocker(connection_body);
       }
       void unblock()
       {
@@ -15,22 +15,53 @@
 #include <algorithm>
 #include <boost/assert.hpp>
 #include <boost/config.hpp>
+#include <boost/core/allocator_access.hpp>
 #include <boost/core/noncopyable.hpp>
 #include <boost/function.hpp>
+#include <boost/mpl/bool.hpp>
 #include <boost/mpl/identity.hpp>
+#include <boost/mpl/if.hpp>
+#include <boost/mpl/void.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/smart_ptr/make_shared.hpp>
+#if !defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) && !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+#include <boost/smart_ptr/local_shared_ptr.hpp>
+#include <boost/smart_ptr/make_local_shared.hpp>
+#endif
+#include <boost/throw_exception.hpp>
+#include <boost/type_traits/decay.hpp>
+#include <boost/type_traits/has_trivial_constructor.hpp>
+#include <boost/type_traits/is_default_constructible.hpp>
+#include <boost/type_traits/is_empty.hpp>
+#include <boost/type_traits/is_function.hpp>
+#include <boost/type_traits/is_pointer.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/remove_pointer.hpp>
 #include <boost/signals2/connection.hpp>
+#include <boost/signals2/connection_handle.hpp>
 #include <boost/signals2/detail/unique_lock.hpp>
+#include <boost/signals2/detail/lazy_shared_ptr.hpp>
+#include <boost/signals2/detail/rcu_shared_ptr.hpp>
 #include <boost/signals2/detail/replace_slot_function.hpp>
 #include <boost/signals2/detail/result_type_wrapper.hpp>
 #include <boost/signals2/detail/signals_common.hpp>
 #include <boost/signals2/detail/signals_common_macros.hpp>
 #include <boost/signals2/detail/slot_groups.hpp>
 #include <boost/signals2/detail/slot_call_iterator.hpp>
+#include <boost/signals2/detail/slot_index.hpp>
+#include <boost/signals2/detail/slot_table.hpp>
+#include <boost/signals2/garbage_collection.hpp>
+#include <boost/signals2/last_value.hpp>
 #include <boost/signals2/optional_last_value.hpp>
 #include <boost/signals2/mutex.hpp>
+#include <boost/signals2/rcu_mutex.hpp>
+#include <boost/signals2/single_threaded.hpp>
 #include <boost/signals2/slot.hpp>
+#include <boost/signals2/slot_storage.hpp>
 #include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
 
 #ifdef BOOST_NO_CXX11_VARIADIC_TEMPLATES
 #include <boost/signals2/preprocessed_signal.hpp>
@@ -49,10 +80,13 @@ namespace boost
       typename GroupCompare,
       typename SlotFunction,
       typename ExtendedSlotFunction,
-      typename Mutex>
+      typename Mutex,
+      typename SlotStorage,
+      typename Allocator,
+      typename GarbageCollection>
       void swap(
-        signal<Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex> &sig1,
-        signal<Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex> &sig2) BOOST_NOEXCEPT
+        signal<Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection> &sig1,
+        signal<Signature, Combiner, Group, GroupCompare, SlotFunction, ExtendedSlotFunction, Mutex, SlotStorage, Allocator, GarbageCollection> &sig2) BOOST_NOEXCEPT
     {
       sig1.swap(sig2);
     }
@@ -19,8 +19,8 @@
 
 #include <boost/parameter/config.hpp>
 
-#if BOOST_PARAMETER_MAX_ARITY < 7
-#error Define BOOST_PARAMETER_MAX_ARITY as 7 or greater.
+#if BOOST_PARAMETER_MAX_ARITY < 8
+#error Define BOOST_PARAMETER_MAX_ARITY as 8 or greater.
 #endif
 
 #include <boost/parameter/template_keyword.hpp>
@@ -32,6 +32,7 @@
 #include <boost/type_traits/function_traits.hpp>
 #include <boost/signals2/signal.hpp>
 #include <functional>
+#include <memory>
 
 namespace boost
 {
@@ -46,6 +47,13 @@ namespace boost
       BOOST_PARAMETER_TEMPLATE_KEYWORD(slot_function_type)
       BOOST_PARAMETER_TEMPLATE_KEYWORD(extended_slot_function_type)
       BOOST_PARAMETER_TEMPLATE_KEYWORD(mutex_type)
+      BOOST_PARAMETER_TEMPLATE_KEYWORD(slot_storage_type)
+#if BOOST_PARAMETER_MAX_ARITY >= 9
+      BOOST_PARAMETER_TEMPLATE_KEYWORD(allocator_type)
+#endif
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+      BOOST_PARAMETER_TEMPLATE_KEYWORD(garbage_collection_type)
+#endif
     } // namespace keywords
 
     template <
@@ -55,7 +63,14 @@ namespace boost
         typename A3 = parameter::void_,
         typename A4 = parameter::void_,
         typename A5 = parameter::void_,
-        typename A6 = parameter::void_
+        typename A6 = parameter::void_,
+        typename A7 = parameter::void_
+#if BOOST_PARAMETER_MAX_ARITY >= 9
+        , typename A8 = parameter::void_
+#endif
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+        , typename A9 = parameter::void_
+#endif
       >
     class signal_type
     {
@@ -66,13 +81,28 @@ namespace boost
           parameter::optional<keywords::tag::group_compare_type>,
           parameter::optional<keywords::tag::slot_function_type>,
           parameter::optional<keywords::tag::extended_slot_function_type>,
-          parameter::optional<keywords::tag::mutex_type>
+          parameter::optional<keywords::tag::mutex_type>,
+          parameter::optional<keywords::tag::slot_storage_type>
+#if BOOST_PARAMETER_MAX_ARITY >= 9
+          , parameter::optional<keywords::tag::allocator_type>
+#endif
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+          , parameter::optional<keywords::tag::garbage_collection_type>
+#endif
         > parameter_spec;
 
     public:
       // ArgumentPack
-      typedef typename parameter_spec::bind<A0, A1, A2, A3, A4, A5, A6>::type
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+      typedef typename parameter_spec::bind<A0, A1, A2, A3, A4, A5, A6, A7, A8, A9>::type
+        args;
+#elif BOOST_PARAMETER_MAX_ARITY >= 9
+      typedef typename parameter_spec::bind<A0, A1, A2, A3, A4, A5, A6, A7, A8>::type
         args;
+#else
+      typedef typename parameter_spec::bind<A0, A1, A2, A3, A4, A5, A6, A7>::type
+        args;
+#endif
 
       typedef typename parameter::value_type<args, keywords::tag::signature_type>::type
         signature_type;
@@ -110,6 +140,28 @@ namespace boost
       typedef typename
         parameter::value_type<args, keywords::tag::mutex_type, mutex>::type mutex_type;
 
+      typedef typename
+        parameter::value_type<args, keywords::tag::slot_storage_type, vector_slot_storage>::type
+        slot_storage_type;
+
+#if BOOST_PARAMETER_MAX_ARITY >= 9
+      typedef typename
+        parameter::value_type<args, keywords::tag::allocator_type, std::allocator<void> >::type
+        allocator_type;
+#else
+      // the allocator can only be chosen by naming signal's template parameters directly
+      typedef std::allocator<void> allocator_type;
+#endif
+
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+      typedef typename
+        parameter::value_type<args, keywords::tag::garbage_collection_type, eager_garbage_collection>::type
+        garbage_collection_type;
+#else
+      // the garbage collection policy can only be chosen by naming signal's template parameters directly
+      typedef eager_garbage_collection garbage_collection_type;
+#endif
+
       typedef signal
         <
           signature_type,
@@ -118,7 +170,10 @@ namespace boost
           group_compare_type,
           slot_function_type,
           extended_slot_function_type,
-          mutex_type
+          mutex_type,
+          slot_storage_type,
+          allocator_type,
+          garbage_collection_type
         > type;
     };
   } // namespace signals2
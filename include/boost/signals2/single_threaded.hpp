@@ -0,0 +1,62 @@
+// A threading policy for signals which are only ever used by one thread.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_SINGLE_THREADED_HPP
+#define BOOST_SIGNALS2_SINGLE_THREADED_HPP
+
+#include <boost/assert.hpp>
+#include <boost/config.hpp>
+#include <boost/mpl/bool.hpp>
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+#include <thread>
+#endif
+
+namespace boost {
+  namespace signals2 {
+    /* Passed as the Mutex of a signal which only one thread ever uses.
+    Locking it does nothing, as with dummy_mutex, and the signal's
+    connection bodies and invocation state also drop their atomic reference
+    counts for plain ones.  In debug builds locking it asserts that it is
+    always locked by the thread which locked it first. */
+    class single_threaded
+    {
+    public:
+      void lock() {check_owner();}
+      bool try_lock() {check_owner(); return true;}
+      void unlock() {}
+    private:
+      void check_owner()
+      {
+#if !defined(BOOST_ASSERT_IS_VOID) && !defined(BOOST_NO_CXX11_HDR_THREAD)
+        const std::thread::id current = std::this_thread::get_id();
+        if(_owner == std::thread::id()) _owner = current;
+        BOOST_ASSERT_MSG(_owner == current,
+          "a signal using boost::signals2::single_threaded was used by more than one thread");
+#endif
+      }
+
+#ifndef BOOST_NO_CXX11_HDR_THREAD
+      std::thread::id _owner;
+#endif
+    };
+
+    namespace detail
+    {
+      template<typename Mutex>
+      class is_single_threaded: public mpl::false_
+      {};
+      template<>
+      class is_single_threaded<single_threaded>: public mpl::true_
+      {};
+    } // end namespace detail
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_SINGLE_THREADED_HPP
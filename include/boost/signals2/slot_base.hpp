@@ -14,6 +14,7 @@
 
 #include <boost/shared_ptr.hpp>
 #include <boost/weak_ptr.hpp>
+#include <boost/signals2/detail/auto_buffer.hpp>
 #include <boost/signals2/detail/foreign_ptr.hpp>
 #include <boost/signals2/expired_slot.hpp>
 #include <boost/signals2/signal_base.hpp>
@@ -64,7 +65,10 @@ namespace boost
     class slot_base
     {
     public:
-      typedef std::vector<detail::void_weak_ptr_variant> tracked_container_type;
+      // room for one tracked object inside the slot, so copying a slot
+      // tracking a single object does not allocate
+      typedef detail::auto_buffer<detail::void_weak_ptr_variant, detail::store_n_objects<1> >
+        tracked_container_type;
       typedef std::vector<detail::void_shared_ptr_variant> locked_container_type;
 
       const tracked_container_type& tracked_objects() const {return _tracked_objects;}
@@ -0,0 +1,98 @@
+// Selectors for the container a signal keeps its connections in,
+// passed as the SlotStorage template parameter of a signal.
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#ifndef BOOST_SIGNALS2_SLOT_STORAGE_HPP
+#define BOOST_SIGNALS2_SLOT_STORAGE_HPP
+
+#include <boost/core/allocator_access.hpp>
+#include <boost/signals2/detail/grouped_vector.hpp>
+#include <boost/signals2/detail/persistent_vector.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+#include <boost/signals2/detail/small_vector.hpp>
+#include <boost/signals2/detail/ungrouped_vector.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace boost {
+  namespace signals2 {
+    // contiguous storage with a sorted index of groups, the default
+    class vector_slot_storage
+    {
+    public:
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class apply
+      {
+      public:
+        typedef detail::grouped_vector<Group, GroupCompare, ValueType, Allocator> type;
+      };
+    };
+    // linked list with a map of groups, so inserting and erasing slots
+    // is independent of how many are connected
+    class list_slot_storage
+    {
+    public:
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class apply
+      {
+      public:
+        typedef detail::grouped_list<Group, GroupCompare, ValueType, Allocator> type;
+      };
+    };
+    // contiguous storage without any group index, for signals which
+    // connect few or no grouped slots
+    class ungrouped_slot_storage
+    {
+    public:
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class apply
+      {
+      public:
+        typedef detail::ungrouped_vector<Group, GroupCompare, ValueType, Allocator> type;
+      };
+    };
+    // chunks of contiguous storage shared between copies of the slot list,
+    // so connecting or disconnecting while the signal is being invoked
+    // copies a chunk instead of every connection
+    class persistent_slot_storage
+    {
+    public:
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class apply
+      {
+      public:
+        typedef detail::persistent_vector<Group, GroupCompare, ValueType, Allocator> type;
+      };
+    };
+    // the first N slots kept inside the slot list itself, and all of them
+    // moved to the heap once there are more, for signals which almost
+    // always have one or two slots.  There is no group index, as for
+    // ungrouped_slot_storage.
+    template<std::size_t N = 4>
+    class small_slot_storage
+    {
+    public:
+      template<typename Group, typename GroupCompare, typename ValueType,
+        typename Allocator = std::allocator<ValueType> >
+      class apply
+      {
+        typedef typename boost::allocator_rebind<Allocator, ValueType>::type value_allocator_type;
+      public:
+        typedef detail::ungrouped_vector<Group, GroupCompare, ValueType, Allocator,
+          detail::small_vector<ValueType, N, value_allocator_type> > type;
+      };
+    };
+  } // end namespace signals2
+} // end namespace boost
+
+#endif // BOOST_SIGNALS2_SLOT_STORAGE_HPP
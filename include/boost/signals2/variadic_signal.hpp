@@ -21,6 +21,7 @@
 #include <boost/signals2/detail/variadic_arg_type.hpp>
 #include <boost/signals2/detail/variadic_slot_invoker.hpp>
 #include <boost/smart_ptr/make_shared.hpp>
+#include <boost/tuple/tuple.hpp>
 #include <boost/type_traits/function_traits.hpp>
 #include <boost/type_traits/is_void.hpp> 
 
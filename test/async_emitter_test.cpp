@@ -0,0 +1,379 @@
+// Tests for boost::signals2::async_emitter
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2/async_emitter.hpp>
+#define BOOST_TEST_MODULE async_emitter_test
+#include <boost/test/included/unit_test.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_NO_CXX11_RVALUE_REFERENCES) || \
+  defined(BOOST_NO_CXX11_HDR_FUTURE) || defined(BOOST_NO_CXX11_HDR_THREAD) || \
+  defined(BOOST_NO_CXX11_HDR_MUTEX) || defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+// holds the tasks it is given until they are run, and can be made to refuse them
+class manual_executor
+{
+public:
+  manual_executor(): refuse(false) {}
+  void execute(std::function<void ()> task)
+  {
+    if(refuse) throw std::runtime_error("executor refused task");
+    tasks.push_back(task);
+  }
+  void run_next()
+  {
+    std::function<void ()> task = tasks.front();
+    tasks.erase(tasks.begin());
+    task();
+  }
+  bool refuse;
+  std::vector<std::function<void ()> > tasks;
+};
+
+void test_refused_task()
+{
+  typedef bs2::signal<void (int)> signal_type;
+  typedef bs2::async_emitter<signal_type, manual_executor> emitter_type;
+  signal_type sig;
+  sig.connect(&receive);
+  received.clear();
+  manual_executor executor;
+  emitter_type emitter(sig, executor, 1000);
+  const int count = emitter_type::emissions_per_task + 10;
+  for(int i = 0; i < count; ++i)
+    emitter.post(i);
+  BOOST_REQUIRE_EQUAL(executor.tasks.size(), 1u);
+  // the task can't hand the executor its continuation, which mustn't
+  // throw out of the task
+  executor.refuse = true;
+  BOOST_CHECK_NO_THROW(executor.run_next());
+  BOOST_CHECK_EQUAL(received.size(), std::size_t(emitter_type::emissions_per_task));
+  BOOST_CHECK(executor.tasks.empty());
+  // the next emission schedules the rest of the queue
+  executor.refuse = false;
+  emitter.post(count);
+  BOOST_REQUIRE_EQUAL(executor.tasks.size(), 1u);
+  executor.run_next();
+  BOOST_REQUIRE_EQUAL(received.size(), std::size_t(count + 1));
+  for(int i = 0; i <= count; ++i)
+    BOOST_CHECK_EQUAL(received[i], i);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+}
+#else
+
+#include <boost/signals2.hpp>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+// counts how often it is copied on its way to the slots
+class counted
+{
+public:
+  counted() {}
+  counted(const counted &) {++copies;}
+  counted(counted &&) {}
+  static int copies;
+};
+int counted::copies = 0;
+
+int add(int x, int y)
+{
+  return x + y;
+}
+
+void check_counted(const counted &)
+{}
+
+void throw_runtime_error(int)
+{
+  throw std::runtime_error("slot failed");
+}
+
+void test_inline_executor()
+{
+  typedef bs2::signal<int (int, int)> signal_type;
+  signal_type sig;
+  sig.connect(&add);
+  bs2::inline_executor executor;
+  bs2::async_emitter<signal_type, bs2::inline_executor> emitter(sig, executor, 4);
+  std::future<boost::optional<int> > result = emitter.async_emit(1, 2);
+  BOOST_CHECK(result.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+  BOOST_CHECK_EQUAL(*result.get(), 3);
+  BOOST_CHECK(emitter.post(3, 4));
+  BOOST_CHECK_EQUAL(emitter.size(), 0u);
+
+  typedef bs2::signal<void (const counted &)> counted_signal_type;
+  counted_signal_type counted_sig;
+  counted_sig.connect(&check_counted);
+  bs2::async_emitter<counted_signal_type, bs2::inline_executor> counted_emitter(counted_sig, executor, 4);
+  counted::copies = 0;
+  counted_emitter.async_emit(counted()).get();
+  counted_emitter.post(counted());
+  BOOST_CHECK_EQUAL(counted::copies, 0);
+
+  typedef bs2::signal<void (int)> void_signal_type;
+  void_signal_type void_sig;
+  void_sig.connect(&throw_runtime_error);
+  bs2::async_emitter<void_signal_type, bs2::inline_executor> throwing_emitter(void_sig, executor, 4);
+  std::future<void> failed = throwing_emitter.async_emit(1);
+  BOOST_CHECK_THROW(failed.get(), std::runtime_error);
+  // an exception without a future to go to is discarded
+  BOOST_CHECK(throwing_emitter.post(1));
+}
+
+std::vector<int> received;
+
+void receive(int x)
+{
+  received.push_back(x);
+}
+
+void test_thread_pool()
+{
+  typedef bs2::signal<void (int)> signal_type;
+  signal_type sig;
+  sig.connect(&receive);
+  received.clear();
+  {
+    bs2::thread_pool_executor executor(2);
+    bs2::async_emitter<signal_type> emitter(sig, executor, 16);
+    for(int i = 0; i < 1000; ++i)
+      emitter.post(i);
+    emitter.async_emit(1000).get();
+  }
+  // emissions run one at a time, in the order they were queued
+  BOOST_REQUIRE_EQUAL(received.size(), 1001u);
+  for(int i = 0; i < 1001; ++i)
+    BOOST_CHECK_EQUAL(received[i], i);
+}
+
+// holds up the first emission until it is released
+class gate
+{
+public:
+  gate(): _started_future(_started.get_future()), _released_future(_released.get_future())
+  {}
+  int operator()(int x)
+  {
+    if(x == 0)
+    {
+      _started.set_value();
+      _released_future.wait();
+    }
+    return x;
+  }
+  void wait_until_started() {_started_future.wait();}
+  void release() {_released.set_value();}
+private:
+  std::promise<void> _started;
+  std::shared_future<void> _started_future;
+  std::promise<void> _released;
+  std::shared_future<void> _released_future;
+};
+
+typedef bs2::signal<int (int)> gated_signal_type;
+
+void test_fail_on_overflow()
+{
+  gated_signal_type sig;
+  gate g;
+  sig.connect(boost::ref(g));
+  bs2::thread_pool_executor executor;
+  bs2::async_emitter<gated_signal_type> emitter(sig, executor, 2, bs2::fail_on_overflow);
+  std::future<boost::optional<int> > first = emitter.async_emit(0);
+  g.wait_until_started();
+  BOOST_CHECK(emitter.post(1));
+  std::future<boost::optional<int> > second = emitter.async_emit(2);
+  BOOST_CHECK_EQUAL(emitter.size(), 2u);
+  BOOST_CHECK(emitter.post(3) == false);
+  BOOST_CHECK_THROW(emitter.async_emit(4), bs2::emission_queue_full);
+  g.release();
+  BOOST_CHECK_EQUAL(*first.get(), 0);
+  BOOST_CHECK_EQUAL(*second.get(), 2);
+}
+
+void test_drop_oldest_on_overflow()
+{
+  gated_signal_type sig;
+  gate g;
+  sig.connect(boost::ref(g));
+  bs2::thread_pool_executor executor;
+  bs2::async_emitter<gated_signal_type> emitter(sig, executor, 2, bs2::drop_oldest_on_overflow);
+  emitter.post(0);
+  g.wait_until_started();
+  std::future<boost::optional<int> > first = emitter.async_emit(1);
+  std::future<boost::optional<int> > second = emitter.async_emit(2);
+  std::future<boost::optional<int> > third = emitter.async_emit(3);
+  BOOST_CHECK_EQUAL(emitter.size(), 2u);
+  BOOST_CHECK_THROW(first.get(), bs2::emission_dropped);
+  g.release();
+  BOOST_CHECK_EQUAL(*second.get(), 2);
+  BOOST_CHECK_EQUAL(*third.get(), 3);
+}
+
+void test_block_on_overflow()
+{
+  gated_signal_type sig;
+  gate g;
+  sig.connect(boost::ref(g));
+  bs2::thread_pool_executor executor;
+  bs2::async_emitter<gated_signal_type> emitter(sig, executor, 1);
+  BOOST_CHECK(emitter.policy() == bs2::block_on_overflow);
+  emitter.post(0);
+  g.wait_until_started();
+  emitter.post(1);
+  std::future<boost::optional<int> > blocked;
+  std::thread producer([&emitter, &blocked]() {blocked = emitter.async_emit(2);});
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  BOOST_CHECK_EQUAL(emitter.size(), 1u);
+  g.release();
+  producer.join();
+  BOOST_CHECK_EQUAL(*blocked.get(), 2);
+}
+
+// holds the tasks it is given until they are run, and can be made to refuse them
+class manual_executor
+{
+public:
+  manual_executor(): refuse(false) {}
+  void execute(std::function<void ()> task)
+  {
+    if(refuse) throw std::runtime_error("executor refused task");
+    tasks.push_back(task);
+  }
+  void run_next()
+  {
+    std::function<void ()> task = tasks.front();
+    tasks.erase(tasks.begin());
+    task();
+  }
+  bool refuse;
+  std::vector<std::function<void ()> > tasks;
+};
+
+void test_refused_task()
+{
+  typedef bs2::signal<void (int)> signal_type;
+  typedef bs2::async_emitter<signal_type, manual_executor> emitter_type;
+  signal_type sig;
+  sig.connect(&receive);
+  received.clear();
+  manual_executor executor;
+  emitter_type emitter(sig, executor, 1000);
+  const int count = emitter_type::emissions_per_task + 10;
+  for(int i = 0; i < count; ++i)
+    emitter.post(i);
+  BOOST_REQUIRE_EQUAL(executor.tasks.size(), 1u);
+  // the task can't hand the executor its continuation, which mustn't
+  // throw out of the task
+  executor.refuse = true;
+  BOOST_CHECK_NO_THROW(executor.run_next());
+  BOOST_CHECK_EQUAL(received.size(), std::size_t(emitter_type::emissions_per_task));
+  BOOST_CHECK(executor.tasks.empty());
+  // the next emission schedules the rest of the queue
+  executor.refuse = false;
+  emitter.post(count);
+  BOOST_REQUIRE_EQUAL(executor.tasks.size(), 1u);
+  executor.run_next();
+  BOOST_REQUIRE_EQUAL(received.size(), std::size_t(count + 1));
+  for(int i = 0; i <= count; ++i)
+    BOOST_CHECK_EQUAL(received[i], i);
+}
+
+// an emission whose task the executor refuses isn't left queued
+void test_refused_emission()
+{
+  typedef bs2::signal<void (int)> signal_type;
+  typedef bs2::async_emitter<signal_type, manual_executor> emitter_type;
+  signal_type sig;
+  sig.connect(&receive);
+  received.clear();
+  manual_executor executor;
+  {
+    emitter_type emitter(sig, executor, 4);
+    executor.refuse = true;
+    BOOST_CHECK_THROW(emitter.async_emit(0), std::runtime_error);
+    BOOST_CHECK_THROW(emitter.post(1), std::runtime_error);
+    BOOST_CHECK_EQUAL(emitter.size(), 0u);
+    executor.refuse = false;
+    emitter.post(2);
+    BOOST_REQUIRE_EQUAL(executor.tasks.size(), 1u);
+    executor.run_next();
+    BOOST_REQUIRE_EQUAL(received.size(), 1u);
+    BOOST_CHECK_EQUAL(received[0], 2);
+  }
+
+  // emissions stranded by a refused continuation are dropped by the destructor
+  received.clear();
+  std::vector<std::future<void> > results;
+  {
+    emitter_type emitter(sig, executor, 1000);
+    const int count = emitter_type::emissions_per_task + 2;
+    for(int i = 0; i < count; ++i)
+      results.push_back(emitter.async_emit(i));
+    executor.refuse = true;
+    executor.run_next();
+    executor.refuse = false;
+    BOOST_CHECK_EQUAL(emitter.size(), 2u);
+  }
+  BOOST_CHECK_EQUAL(received.size(), std::size_t(emitter_type::emissions_per_task));
+  BOOST_CHECK_NO_THROW(results.front().get());
+  BOOST_CHECK_THROW(results.back().get(), bs2::emission_dropped);
+}
+
+typedef bs2::signal<void (int)> reentrant_signal_type;
+typedef bs2::async_emitter<reentrant_signal_type, bs2::inline_executor> reentrant_emitter_type;
+std::vector<bool> reentrant_posts;
+
+// posts twice onto its own emitter, whose queue only has room for one
+void post_again(reentrant_emitter_type &emitter, int x)
+{
+  if(x != 0) return;
+  reentrant_posts.push_back(emitter.post(1));
+  reentrant_posts.push_back(emitter.post(2));
+}
+
+// a slot blocking on its own full emitter would wait for itself forever
+void test_reentrant_block_on_overflow()
+{
+  reentrant_signal_type sig;
+  bs2::inline_executor executor;
+  reentrant_emitter_type emitter(sig, executor, 1);
+  sig.connect(boost::bind(&post_again, boost::ref(emitter), boost::placeholders::_1));
+  sig.connect(&receive);
+  received.clear();
+  reentrant_posts.clear();
+  emitter.post(0);
+  BOOST_REQUIRE_EQUAL(reentrant_posts.size(), 2u);
+  BOOST_CHECK(reentrant_posts[0]);
+  BOOST_CHECK(reentrant_posts[1] == false);
+  BOOST_REQUIRE_EQUAL(received.size(), 2u);
+  BOOST_CHECK_EQUAL(received[0], 0);
+  BOOST_CHECK_EQUAL(received[1], 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_inline_executor();
+  test_thread_pool();
+  test_fail_on_overflow();
+  test_drop_oldest_on_overflow();
+  test_block_on_overflow();
+  test_refused_task();
+  test_refused_emission();
+  test_reentrant_block_on_overflow();
+}
+
+#endif
@@ -0,0 +1,180 @@
+// Tests for boost::signals2::connection_batch and boost::signals2::connection_set
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#define BOOST_TEST_MODULE connection_batch_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/bind/bind.hpp>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+typedef bs2::signal<void ()> signal_type;
+typedef bs2::signal<void (), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void ()>, boost::function<void (const bs2::connection &)>,
+  bs2::rcu_mutex<bs2::mutex> > rcu_signal_type;
+
+std::vector<int> calls;
+
+void record(int id)
+{
+  calls.push_back(id);
+}
+
+template<typename Signal>
+void test_ordering()
+{
+  Signal sig;
+  sig.connect(boost::bind(&record, 0));
+  bs2::connection_batch<Signal> batch(sig);
+  batch.connect(boost::bind(&record, 1));
+  batch.connect(boost::bind(&record, 2), bs2::at_front);
+  batch.connect(2, boost::bind(&record, 3));
+  batch.connect(1, boost::bind(&record, 4));
+  BOOST_CHECK_EQUAL(batch.size(), 4u);
+  // pending connections count as connected, but are not invoked yet
+  BOOST_CHECK_EQUAL(sig.num_slots(), 5u);
+  calls.clear();
+  sig();
+  BOOST_REQUIRE_EQUAL(calls.size(), 1u);
+  batch.commit();
+  BOOST_CHECK(batch.empty());
+  calls.clear();
+  sig();
+  const int expected[] = {2, 4, 3, 0, 1};
+  BOOST_CHECK_EQUAL_COLLECTIONS(calls.begin(), calls.end(), expected, expected + 5);
+}
+
+template<typename Signal>
+void test_disconnections()
+{
+  Signal sig;
+  bs2::connection c0 = sig.connect(boost::bind(&record, 0));
+  bs2::connection c1 = sig.connect(boost::bind(&record, 1));
+  bs2::connection_batch<Signal> batch(sig);
+  bs2::connection c2 = batch.connect(boost::bind(&record, 2));
+  bs2::connection c3 = batch.connect(boost::bind(&record, 3));
+  batch.disconnect(c0);
+  batch.disconnect(c3);
+  // disconnecting a pending connection directly works too
+  c2.disconnect();
+  BOOST_CHECK(c0.connected());
+  BOOST_CHECK_EQUAL(sig.num_slots(), 3u);
+  batch.commit();
+  BOOST_CHECK(c0.connected() == false);
+  BOOST_CHECK(c1.connected());
+  BOOST_CHECK(c2.connected() == false);
+  BOOST_CHECK(c3.connected() == false);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+  calls.clear();
+  sig();
+  BOOST_REQUIRE_EQUAL(calls.size(), 1u);
+  BOOST_CHECK_EQUAL(calls[0], 1);
+}
+
+template<typename Signal>
+void test_rollback()
+{
+  Signal sig;
+  bs2::connection c0 = sig.connect(boost::bind(&record, 0));
+  bs2::connection c1;
+  {
+    bs2::connection_batch<Signal> batch(sig);
+    c1 = batch.connect(boost::bind(&record, 1));
+    batch.disconnect(c0);
+    BOOST_CHECK(c1.connected());
+  }
+  BOOST_CHECK(c0.connected());
+  BOOST_CHECK(c1.connected() == false);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+  calls.clear();
+  sig();
+  BOOST_REQUIRE_EQUAL(calls.size(), 1u);
+  BOOST_CHECK_EQUAL(calls[0], 0);
+}
+
+// a batch committed by a slot doesn't change the invocation in progress
+template<typename Signal>
+void commit_from_slot(Signal &sig, std::vector<bs2::connection> &connections)
+{
+  calls.push_back(-1);
+  if(connections.empty() == false) return;
+  bs2::connection_batch<Signal> batch(sig);
+  for(int i = 0; i < 10; ++i)
+    connections.push_back(batch.connect(boost::bind(&record, i)));
+  batch.commit();
+}
+
+template<typename Signal>
+void test_commit_during_invocation()
+{
+  Signal sig;
+  std::vector<bs2::connection> connections;
+  sig.connect(boost::bind(&commit_from_slot<Signal>, boost::ref(sig), boost::ref(connections)));
+  calls.clear();
+  sig();
+  BOOST_CHECK_EQUAL(calls.size(), 1u);
+  calls.clear();
+  sig();
+  BOOST_CHECK_EQUAL(calls.size(), 11u);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_ordering<signal_type>();
+  test_ordering<rcu_signal_type>();
+  test_disconnections<signal_type>();
+  test_disconnections<rcu_signal_type>();
+  test_rollback<signal_type>();
+  test_rollback<rcu_signal_type>();
+  test_commit_during_invocation<signal_type>();
+  test_commit_during_invocation<rcu_signal_type>();
+}
+
+BOOST_AUTO_TEST_CASE(test_connection_set)
+{
+  signal_type sig1;
+  rcu_signal_type sig2;
+  bs2::connection kept = sig1.connect(boost::bind(&record, 0));
+  {
+    bs2::connection_set connections;
+    for(int i = 0; i < 5; ++i)
+    {
+      connections.add(sig1.connect(boost::bind(&record, 1)));
+      connections += sig2.connect(boost::bind(&record, 2));
+    }
+    connections += bs2::connection();
+    BOOST_CHECK_EQUAL(connections.size(), 11u);
+    BOOST_CHECK_EQUAL(sig1.num_slots(), 6u);
+    BOOST_CHECK_EQUAL(sig2.num_slots(), 5u);
+  }
+  BOOST_CHECK_EQUAL(sig1.num_slots(), 1u);
+  BOOST_CHECK_EQUAL(sig2.num_slots(), 0u);
+  BOOST_CHECK(kept.connected());
+
+  bs2::connection released;
+  {
+    bs2::connection_set connections;
+    released = sig2.connect(boost::bind(&record, 2));
+    connections += released;
+    connections.release();
+    BOOST_CHECK(connections.empty());
+  }
+  BOOST_CHECK(released.connected());
+
+  // a batch can disconnect connections to other signals too
+  bs2::connection_batch<signal_type> batch(sig1);
+  batch.disconnect(released);
+  batch.disconnect(kept);
+  batch.commit();
+  BOOST_CHECK(released.connected() == false);
+  BOOST_CHECK(kept.connected() == false);
+  BOOST_CHECK(sig1.empty());
+  BOOST_CHECK(sig2.empty());
+}
@@ -0,0 +1,189 @@
+// Tests for boost::signals2::connection_handle
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#define BOOST_TEST_MODULE connection_handle_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <set>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+typedef bs2::signal<void ()> signal_type;
+typedef bs2::signal<void (), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void ()>, boost::function<void (const bs2::connection &)>,
+  bs2::rcu_mutex<bs2::mutex> > rcu_signal_type;
+
+std::vector<int> calls;
+
+void record(int id)
+{
+  calls.push_back(id);
+}
+
+template<typename Signal>
+void test_connect_and_disconnect()
+{
+  Signal sig;
+  const bs2::connection_handle h0 = sig.connect_handle(boost::bind(&record, 0));
+  const bs2::connection_handle h1 = sig.connect_handle(1, boost::bind(&record, 1));
+  const bs2::connection_handle h2 = sig.connect_handle(boost::bind(&record, 2), bs2::at_front);
+  BOOST_CHECK(h0.null() == false);
+  BOOST_CHECK(h0 != h1);
+  BOOST_CHECK(h1 != h2);
+  BOOST_CHECK(sig.connected(h0));
+  BOOST_CHECK(sig.connected(h1));
+  BOOST_CHECK(sig.connected(h2));
+  BOOST_CHECK(sig.connected(bs2::connection_handle()) == false);
+  calls.clear();
+  sig();
+  const int expected[] = {2, 1, 0};
+  BOOST_CHECK_EQUAL_COLLECTIONS(calls.begin(), calls.end(), expected, expected + 3);
+
+  // disconnecting through the handle
+  sig.disconnect(h1);
+  BOOST_CHECK(sig.connected(h1) == false);
+  BOOST_CHECK(sig.get_connection(h1).connected() == false);
+  // disconnecting through the connection
+  bs2::connection c0 = sig.get_connection(h0);
+  BOOST_CHECK(c0.connected());
+  c0.disconnect();
+  BOOST_CHECK(sig.connected(h0) == false);
+  // disconnecting everything
+  sig.disconnect_all_slots();
+  BOOST_CHECK(sig.connected(h2) == false);
+  calls.clear();
+  sig();
+  BOOST_CHECK(calls.empty());
+}
+
+template<typename Signal>
+void test_stale_handles()
+{
+  Signal sig;
+  std::vector<bs2::connection_handle> handles;
+  for(int i = 0; i < 100; ++i)
+    handles.push_back(sig.connect_handle(boost::bind(&record, i)));
+  for(int i = 0; i < 100; i += 2)
+    sig.disconnect(handles[i]);
+  sig.collect_garbage();
+  // the freed entries are reused, under a new generation
+  std::set<boost::uint32_t> freed;
+  for(int i = 0; i < 100; i += 2)
+    freed.insert(handles[i].index());
+  std::vector<bs2::connection_handle> fresh;
+  for(int i = 0; i < 50; ++i)
+  {
+    fresh.push_back(sig.connect_handle(boost::bind(&record, 100 + i)));
+    BOOST_CHECK(freed.count(fresh.back().index()) == 1);
+  }
+  for(int i = 0; i < 100; ++i)
+    BOOST_CHECK(sig.connected(handles[i]) == (i % 2 != 0));
+  for(int i = 0; i < 50; ++i)
+    BOOST_CHECK(sig.connected(fresh[i]));
+  // a stale handle can't disconnect the connection now in its entry
+  for(int i = 0; i < 100; i += 2)
+    sig.disconnect(handles[i]);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 100u);
+  calls.clear();
+  sig();
+  BOOST_CHECK_EQUAL(calls.size(), 100u);
+}
+
+template<typename Signal>
+void test_tracked()
+{
+  Signal sig;
+  boost::shared_ptr<int> tracked = boost::make_shared<int>(0);
+  const bs2::connection_handle h = sig.connect_handle(
+    typename Signal::slot_type(&record, 0).track(tracked));
+  BOOST_CHECK(sig.connected(h));
+  tracked.reset();
+  // the slot expired without being disconnected
+  BOOST_CHECK(sig.connected(h) == false);
+  calls.clear();
+  sig();
+  BOOST_CHECK(calls.empty());
+}
+
+// connecting through several of the table's segments, which start at
+// entries 64 and 192
+template<typename Signal>
+void test_segments()
+{
+  Signal sig;
+  std::vector<bs2::connection_handle> handles;
+  for(int i = 0; i < 200; ++i)
+    handles.push_back(sig.connect_handle(boost::bind(&record, i)));
+  for(int i = 0; i < 200; ++i)
+  {
+    BOOST_CHECK_EQUAL(handles[i].index(), boost::uint32_t(i + 1));
+    BOOST_CHECK(sig.connected(handles[i]));
+  }
+  sig.disconnect(handles[64]);
+  sig.disconnect(handles[192]);
+  BOOST_CHECK(sig.connected(handles[63]));
+  BOOST_CHECK(sig.connected(handles[64]) == false);
+  BOOST_CHECK(sig.connected(handles[192]) == false);
+  calls.clear();
+  sig();
+  BOOST_CHECK_EQUAL(calls.size(), 198u);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_connect_and_disconnect<signal_type>();
+  test_connect_and_disconnect<rcu_signal_type>();
+  test_stale_handles<signal_type>();
+  test_stale_handles<rcu_signal_type>();
+  test_tracked<signal_type>();
+  test_tracked<rcu_signal_type>();
+  test_segments<signal_type>();
+  test_segments<rcu_signal_type>();
+}
+
+BOOST_AUTO_TEST_CASE(test_connection_interop)
+{
+  signal_type sig;
+  const bs2::connection_handle h = sig.connect_handle(boost::bind(&record, 0));
+  {
+    bs2::shared_connection_block block(sig.get_connection(h));
+    BOOST_CHECK(sig.connected(h));
+    calls.clear();
+    sig();
+    BOOST_CHECK(calls.empty());
+  }
+  calls.clear();
+  sig();
+  BOOST_CHECK_EQUAL(calls.size(), 1u);
+  {
+    bs2::scoped_connection scoped(sig.get_connection(h));
+  }
+  BOOST_CHECK(sig.connected(h) == false);
+
+  // handles are plain values
+  const bs2::connection_handle a(1, 2), b(a.value());
+  BOOST_CHECK(a == b);
+  BOOST_CHECK_EQUAL(b.index(), 1u);
+  BOOST_CHECK_EQUAL(b.generation(), 2u);
+  BOOST_CHECK(bs2::connection_handle() < a);
+  BOOST_CHECK(bs2::connection_handle().null());
+
+  // a signal which never handed out handles knows of none
+  signal_type other;
+  BOOST_CHECK(other.connected(a) == false);
+  other.connect(boost::bind(&record, 0));
+  BOOST_CHECK(other.connected(a) == false);
+  BOOST_CHECK(other.get_connection(a) == bs2::connection());
+  other.disconnect(a);
+  BOOST_CHECK_EQUAL(other.num_slots(), 1u);
+}
@@ -8,7 +8,10 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 
 // For more information, see http://www.boost.org
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/signals2.hpp>
+#include <boost/weak_ptr.hpp>
 #define BOOST_TEST_MODULE connection_test
 #include <boost/test/included/unit_test.hpp>
 
@@ -19,6 +22,9 @@ typedef bs2::signal<void ()> sig_type;
 void myslot()
 {}
 
+void bound_slot(const boost::shared_ptr<int> &)
+{}
+
 void swap_test()
 {
   sig_type sig;
@@ -122,9 +128,34 @@ void move_test()
 #endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
 }
 
+// the slot is destroyed as soon as it is disconnected, although the
+// connection body holding it lives on in the signal
+void slot_release_test()
+{
+  sig_type sig;
+  boost::shared_ptr<int> bound = boost::make_shared<int>(0);
+  boost::shared_ptr<int> tracked = boost::make_shared<int>(0);
+  const boost::weak_ptr<int> weak_bound = bound;
+  bs2::connection conn = sig.connect(sig_type::slot_type(boost::bind(&bound_slot, bound)).track(tracked));
+  bound.reset();
+  BOOST_CHECK(weak_bound.expired() == false);
+  sig();
+  conn.disconnect();
+  BOOST_CHECK(weak_bound.expired());
+
+  bound = boost::make_shared<int>(0);
+  const boost::weak_ptr<int> weak_bound2 = bound;
+  sig.connect(sig_type::slot_type(boost::bind(&bound_slot, bound)).track(tracked));
+  bound.reset();
+  tracked.reset();
+  sig();
+  BOOST_CHECK(weak_bound2.expired());
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   release_test();
   swap_test();
   move_test();
+  slot_release_test();
 }
@@ -0,0 +1,183 @@
+// Tests for disconnecting slots by their target with signal::disconnect(slot)
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#define BOOST_TEST_MODULE disconnect_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/function.hpp>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+typedef bs2::signal<void (int)> signal_type;
+typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+  bs2::rcu_mutex<bs2::mutex> > rcu_signal_type;
+
+int foo_calls = 0;
+int bar_calls = 0;
+
+void foo(int)
+{
+  ++foo_calls;
+}
+
+void bar(int)
+{
+  ++bar_calls;
+}
+
+void extended_foo(const bs2::connection &, int)
+{
+  ++foo_calls;
+}
+
+class counter
+{
+public:
+  explicit counter(int id): _id(id)
+  {}
+  void operator()(int) const
+  {
+    ++bar_calls;
+  }
+  bool operator==(const counter &other) const
+  {
+    return _id == other._id;
+  }
+private:
+  int _id;
+};
+
+template<typename Signal>
+void check_calls(Signal &sig, int expected_foo, int expected_bar)
+{
+  foo_calls = 0;
+  bar_calls = 0;
+  sig(0);
+  BOOST_CHECK_EQUAL(foo_calls, expected_foo);
+  BOOST_CHECK_EQUAL(bar_calls, expected_bar);
+}
+
+template<typename Signal>
+void test_function_pointers()
+{
+  Signal sig;
+  for(int i = 0; i < 100; ++i)
+  {
+    sig.connect(&foo);
+    sig.connect(&bar);
+  }
+  sig.disconnect(&foo);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 100u);
+  check_calls(sig, 0, 100);
+  // slots connected after the first disconnect are found too
+  for(int i = 0; i < 10; ++i)
+    sig.connect(i, &foo);
+  check_calls(sig, 10, 100);
+  sig.disconnect(&foo);
+  check_calls(sig, 0, 100);
+  sig.disconnect(&bar);
+  BOOST_CHECK(sig.empty());
+}
+
+// functions named without &, which are passed by reference
+template<typename Signal>
+void test_function_references()
+{
+  Signal sig;
+  for(int i = 0; i < 10; ++i)
+  {
+    sig.connect(foo);
+    sig.connect(&bar);
+  }
+  sig.disconnect(foo);
+  check_calls(sig, 0, 10);
+  sig.connect(&foo);
+  sig.connect(1, foo);
+  check_calls(sig, 2, 10);
+  // either spelling finds slots connected with the other
+  sig.disconnect(&foo);
+  check_calls(sig, 0, 10);
+  sig.disconnect(bar);
+  BOOST_CHECK(sig.empty());
+}
+
+// slots whose target is a function pointer, without being made from one
+template<typename Signal>
+void test_wrapped_targets()
+{
+  Signal sig;
+  bs2::connection made_from_function = sig.connect(boost::function<void (int)>(&foo));
+  typename Signal::slot_type modified_slot(&bar);
+  modified_slot.slot_function() = &foo;
+  bs2::connection made_from_modified_slot = sig.connect(modified_slot);
+  bs2::connection extended = sig.connect_extended(&extended_foo);
+  bs2::connection bar_connection = sig.connect(&bar);
+  check_calls(sig, 3, 1);
+  sig.disconnect(&foo);
+  BOOST_CHECK(made_from_function.connected() == false);
+  BOOST_CHECK(made_from_modified_slot.connected() == false);
+  BOOST_CHECK(extended.connected());
+  sig.disconnect(&extended_foo);
+  BOOST_CHECK(extended.connected() == false);
+  BOOST_CHECK(bar_connection.connected());
+  check_calls(sig, 0, 1);
+}
+
+template<typename Signal>
+void test_batch_and_churn()
+{
+  Signal sig;
+  sig.disconnect(&foo);
+  {
+    bs2::connection_batch<Signal> batch(sig);
+    for(int i = 0; i < 10; ++i)
+      batch.connect(&foo);
+    batch.commit();
+  }
+  check_calls(sig, 10, 0);
+  sig.disconnect(&foo);
+  check_calls(sig, 0, 0);
+  // connections which come and go don't pile up in the index
+  sig.connect(&bar);
+  for(int i = 0; i < 1000; ++i)
+  {
+    bs2::connection conn = sig.connect(&foo);
+    if(i % 2) conn.disconnect();
+    else sig.disconnect(&foo);
+  }
+  check_calls(sig, 0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_function_pointers<signal_type>();
+  test_function_references<signal_type>();
+  test_function_pointers<rcu_signal_type>();
+  test_function_references<rcu_signal_type>();
+  test_wrapped_targets<signal_type>();
+  test_wrapped_targets<rcu_signal_type>();
+  test_batch_and_churn<signal_type>();
+  test_batch_and_churn<rcu_signal_type>();
+}
+
+// function objects are still found by going through every slot
+BOOST_AUTO_TEST_CASE(test_function_objects)
+{
+  signal_type sig;
+  sig.connect(counter(1));
+  sig.connect(counter(2));
+  sig.connect(&foo);
+  sig.disconnect(counter(1));
+  BOOST_CHECK_EQUAL(sig.num_slots(), 2u);
+  sig.disconnect(&foo);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+  check_calls(sig, 0, 1);
+}
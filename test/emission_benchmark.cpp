@@ -0,0 +1,522 @@
+/* Microbenchmarks of signal emission, connection and disconnection.
+
+  Each benchmark is run for a growing number of iterations until it takes
+  at least the minimum time, then reported as time per operation, time per
+  slot invoked, and heap allocations per operation.  Pass a substring to
+  run only the benchmarks whose names contain it, and --min_time=<seconds>
+  to change how long each runs for. */
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#include <boost/bind/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2.hpp>
+#include <boost/signals2/detail/atomic.hpp>
+#include <boost/signals2/parallel_combiner.hpp>
+#include <boost/thread/thread.hpp>
+
+namespace bs2 = boost::signals2;
+
+// the parallel_combiner needs the C++11 thread support library
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_LAMBDAS) && \
+  !defined(BOOST_NO_CXX11_HDR_ATOMIC) && !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) && \
+  !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+  !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+#define PARALLEL_COMBINER_AVAILABLE
+#endif
+
+// count every heap allocation made by the program
+bs2::detail::atomic<unsigned long> allocation_count(0);
+
+// kept out of line so the compiler doesn't pair the malloc and free itself
+BOOST_NOINLINE void * operator new(std::size_t size)
+{
+  allocation_count.fetch_add(1, bs2::detail::memory_order_relaxed);
+  void *p = std::malloc(size == 0 ? 1 : size);
+  if(p == 0) throw std::bad_alloc();
+  return p;
+}
+BOOST_NOINLINE void operator delete(void *p) BOOST_NOEXCEPT
+{
+  std::free(p);
+}
+BOOST_NOINLINE void operator delete(void *p, std::size_t) BOOST_NOEXCEPT
+{
+  std::free(p);
+}
+
+double min_time = 0.2;
+const char *filter = 0;
+
+template<typename Benchmark>
+void run(const std::string &name, Benchmark &benchmark)
+{
+  if(filter && name.find(filter) == std::string::npos) return;
+  // warm up caches and any lazily allocated state
+  benchmark(1);
+  unsigned long iterations = 1;
+  double elapsed_ns;
+  unsigned long allocations;
+  for(;;)
+  {
+    const unsigned long allocations_before = allocation_count.load();
+    const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    benchmark(iterations);
+    elapsed_ns = double((boost::posix_time::microsec_clock::universal_time() - start).total_nanoseconds());
+    allocations = allocation_count.load() - allocations_before;
+    if(elapsed_ns >= min_time * 1e9 || iterations >= 1000000000ul) break;
+    // aim a little past the minimum time, growing by at most 10x each round
+    double scale = elapsed_ns > 0 ? min_time * 1.4e9 / elapsed_ns : 10;
+    if(scale > 10) scale = 10;
+    if(scale < 2) scale = 2;
+    iterations = static_cast<unsigned long>(iterations * scale);
+  }
+  const double operations = double(iterations) * benchmark.operations_per_iteration();
+  const double ns_per_op = elapsed_ns / operations;
+  std::printf("%-44s %10.1f ns", name.c_str(), ns_per_op);
+  if(benchmark.slots() > 0)
+    std::printf(" %10.2f", ns_per_op / benchmark.slots());
+  else
+    std::printf(" %10s", "-");
+  std::printf(" %10.2f %12lu\n", allocations / operations, iterations);
+}
+
+std::string format_name(const char *prefix, unsigned n)
+{
+  char buffer[128];
+  std::sprintf(buffer, "%s%u", prefix, n);
+  return buffer;
+}
+
+int sink = 0;
+
+void void_slot(int x)
+{
+  sink += x;
+}
+
+// combiner that adds up the slots' results
+class sum_combiner
+{
+public:
+  typedef int result_type;
+  template<typename InputIterator>
+  int operator()(InputIterator first, InputIterator last) const
+  {
+    int sum = 0;
+    for(; first != last; ++first) sum += *first;
+    return sum;
+  }
+};
+
+// emission of a signal with num_slots connected
+template<typename Signal>
+class emit_benchmark
+{
+public:
+  enum slot_kind {untracked, tracked, grouped};
+
+  emit_benchmark(unsigned num_slots, slot_kind kind = untracked):
+    _num_slots(num_slots), _tracked_object(boost::make_shared<int>(0))
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+    {
+      typename Signal::slot_type slot(&emit_benchmark::slot);
+      if(kind == tracked) slot.track(_tracked_object);
+      if(kind == grouped)
+        _sig.connect(i % 10, slot);
+      else
+        _sig.connect(slot);
+    }
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+      _sig(1);
+  }
+  unsigned slots() const {return _num_slots;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  static typename Signal::slot_result_type slot(int x)
+  {
+    sink += x;
+    return typename Signal::slot_result_type();
+  }
+
+  Signal _sig;
+  unsigned _num_slots;
+  boost::shared_ptr<int> _tracked_object;
+};
+
+// emission of batches of batch_size values with emit_batch, reported per value
+template<typename Signal>
+class batch_benchmark
+{
+public:
+  batch_benchmark(unsigned num_slots, unsigned batch_size, bool tracked):
+    _num_slots(num_slots), _batch(batch_size, 1), _tracked_object(boost::make_shared<int>(0))
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+    {
+      typename Signal::slot_type slot(&void_slot);
+      if(tracked) slot.track(_tracked_object);
+      _sig.connect(slot);
+    }
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+      _sig.emit_batch(_batch.begin(), _batch.end());
+  }
+  unsigned slots() const {return _num_slots;}
+  unsigned operations_per_iteration() const {return _batch.size();}
+private:
+  Signal _sig;
+  unsigned _num_slots;
+  std::vector<int> _batch;
+  boost::shared_ptr<int> _tracked_object;
+};
+
+// connecting a slot then disconnecting it again, with num_slots other slots connected
+template<typename Signal>
+class churn_benchmark
+{
+public:
+  churn_benchmark(unsigned num_slots, bool emit):
+    _num_slots(num_slots), _emit(emit)
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+      _sig.connect(&void_slot);
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+    {
+      bs2::connection conn = _sig.connect(&void_slot);
+      if(_emit) _sig(1);
+      conn.disconnect();
+    }
+  }
+  unsigned slots() const {return _emit ? _num_slots + 1 : 0;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  Signal _sig;
+  unsigned _num_slots;
+  bool _emit;
+};
+
+// constructing a signal, emitting it, and destroying it, with or without
+// connecting a slot to it first
+template<typename Signal>
+class construct_benchmark
+{
+public:
+  explicit construct_benchmark(bool connect): _connect(connect)
+  {}
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+    {
+      Signal sig;
+      if(_connect) sig.connect(&void_slot);
+      sig(1);
+    }
+  }
+  unsigned slots() const {return 0;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  bool _connect;
+};
+
+// connecting num_slots slots then disconnecting them all again, either one
+// at a time or through a connection_batch and a connection_set
+template<typename Signal>
+class wiring_benchmark
+{
+public:
+  wiring_benchmark(unsigned num_slots, bool batched):
+    _num_slots(num_slots), _batched(batched)
+  {
+    _sig.connect(&void_slot);
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+    {
+      if(_batched)
+      {
+        bs2::connection_set connections;
+        bs2::connection_batch<Signal> batch(_sig);
+        for(unsigned j = 0; j < _num_slots; ++j)
+          connections += batch.connect(&void_slot);
+        batch.commit();
+      }else
+      {
+        std::vector<bs2::connection> connections;
+        connections.reserve(_num_slots);
+        for(unsigned j = 0; j < _num_slots; ++j)
+          connections.push_back(_sig.connect(&void_slot));
+        for(unsigned j = 0; j < _num_slots; ++j)
+          connections[j].disconnect();
+      }
+    }
+  }
+  unsigned slots() const {return 0;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  Signal _sig;
+  unsigned _num_slots;
+  bool _batched;
+};
+
+void other_void_slot(int x)
+{
+  sink += x + 1;
+}
+
+// connecting a slot then disconnecting it by function pointer, with
+// num_slots slots of other functions connected
+template<typename Signal>
+class disconnect_slot_benchmark
+{
+public:
+  explicit disconnect_slot_benchmark(unsigned num_slots)
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+      _sig.connect(&other_void_slot);
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+    {
+      _sig.connect(&void_slot);
+      _sig.disconnect(&void_slot);
+    }
+  }
+  unsigned slots() const {return 0;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  Signal _sig;
+};
+
+// num_threads threads emitting the same signal at once
+template<typename Signal>
+class contention_benchmark
+{
+public:
+  contention_benchmark(unsigned num_slots, unsigned num_threads):
+    _num_slots(num_slots), _num_threads(num_threads)
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+      _sig.connect(&void_slot);
+  }
+  void operator()(unsigned long iterations)
+  {
+    boost::thread_group threads;
+    for(unsigned i = 0; i < _num_threads; ++i)
+      threads.create_thread(boost::bind(&contention_benchmark::emit, this, iterations));
+    threads.join_all();
+  }
+  unsigned slots() const {return _num_slots;}
+  unsigned operations_per_iteration() const {return _num_threads;}
+private:
+  void emit(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+      _sig(1);
+  }
+
+  Signal _sig;
+  unsigned _num_slots;
+  unsigned _num_threads;
+};
+
+#ifdef PARALLEL_COMBINER_AVAILABLE
+// emission of num_slots CPU-heavy slots, shared between num_threads threads
+class parallel_benchmark
+{
+public:
+  typedef bs2::signal<int (int), bs2::parallel_combiner<sum_combiner> > signal_type;
+
+  parallel_benchmark(unsigned num_slots, unsigned num_threads):
+    _sig(bs2::parallel_combiner<sum_combiner>(num_threads)), _num_slots(num_slots)
+  {
+    for(unsigned i = 0; i < num_slots; ++i)
+      _sig.connect(&parallel_benchmark::slot);
+  }
+  void operator()(unsigned long iterations)
+  {
+    for(unsigned long i = 0; i < iterations; ++i)
+      sink += _sig(1);
+  }
+  unsigned slots() const {return _num_slots;}
+  unsigned operations_per_iteration() const {return 1;}
+private:
+  static int slot(int x)
+  {
+    // a few microseconds of work
+    unsigned hash = x;
+    for(unsigned i = 0; i < 4096; ++i)
+      hash = hash * 31u + i;
+    return static_cast<int>(hash & 1);
+  }
+
+  signal_type _sig;
+  unsigned _num_slots;
+};
+#endif
+
+template<typename Signal>
+void run_emit(const char *prefix, unsigned num_slots,
+  typename emit_benchmark<Signal>::slot_kind kind = emit_benchmark<Signal>::untracked)
+{
+  emit_benchmark<Signal> benchmark(num_slots, kind);
+  run(format_name(prefix, num_slots), benchmark);
+}
+
+int main(int argc, const char **argv)
+{
+  for(int i = 1; i < argc; ++i)
+  {
+    if(std::strncmp(argv[i], "--min_time=", 11) == 0)
+      min_time = std::atof(argv[i] + 11);
+    else
+      filter = argv[i];
+  }
+
+  typedef bs2::signal<void (int)> void_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::dummy_mutex> dummy_mutex_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::single_threaded> single_threaded_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::mutex, bs2::vector_slot_storage, std::allocator<void>, bs2::deferred_garbage_collection> deferred_gc_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::rcu_mutex<bs2::mutex> > rcu_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::rcu_mutex<bs2::mutex>, bs2::persistent_slot_storage> persistent_rcu_signal;
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::mutex, bs2::small_slot_storage<> > small_signal;
+  typedef bs2::signal<int (int)> optional_last_value_signal;
+  typedef bs2::signal<int (int), bs2::last_value<int> > last_value_signal;
+  typedef bs2::signal<int (int), sum_combiner> sum_signal;
+
+  std::printf("%-44s %13s %10s %10s %12s\n", "Benchmark", "Time/op", "ns/slot", "allocs/op", "Iterations");
+  std::printf("%s\n", std::string(92, '-').c_str());
+
+  const unsigned slot_counts[] = {0, 1, 10, 100, 1000};
+  const unsigned num_slot_counts = sizeof(slot_counts) / sizeof(slot_counts[0]);
+  for(unsigned i = 0; i < num_slot_counts; ++i)
+    run_emit<void_signal>("emit/untracked/slots:", slot_counts[i]);
+  for(unsigned i = 1; i < num_slot_counts; ++i)
+    run_emit<void_signal>("emit/tracked/slots:", slot_counts[i], emit_benchmark<void_signal>::tracked);
+  for(unsigned i = 1; i < num_slot_counts; ++i)
+    run_emit<void_signal>("emit/grouped/slots:", slot_counts[i], emit_benchmark<void_signal>::grouped);
+  for(unsigned i = 0; i < num_slot_counts; ++i)
+    run_emit<dummy_mutex_signal>("emit/dummy_mutex/slots:", slot_counts[i]);
+  for(unsigned i = 0; i < num_slot_counts; ++i)
+    run_emit<single_threaded_signal>("emit/single_threaded/slots:", slot_counts[i]);
+
+  // most signals have one or two slots
+  for(unsigned i = 1; i <= 2; ++i)
+  {
+    run_emit<void_signal>("emit/vector/slots:", i);
+    run_emit<small_signal>("emit/small/slots:", i);
+  }
+
+  construct_benchmark<void_signal> construct_unconnected(false);
+  run("construct/unconnected", construct_unconnected);
+  construct_benchmark<void_signal> construct_connected(true);
+  run("construct/connected", construct_connected);
+  construct_benchmark<small_signal> construct_small(true);
+  run("construct/connected/small", construct_small);
+
+  run_emit<optional_last_value_signal>("combiner/optional_last_value/slots:", 1);
+  run_emit<optional_last_value_signal>("combiner/optional_last_value/slots:", 100);
+  run_emit<last_value_signal>("combiner/last_value/slots:", 1);
+  run_emit<last_value_signal>("combiner/last_value/slots:", 100);
+  run_emit<sum_signal>("combiner/sum/slots:", 1);
+  run_emit<sum_signal>("combiner/sum/slots:", 100);
+
+  const unsigned batch_sizes[] = {1, 16, 256};
+  for(unsigned i = 0; i < sizeof(batch_sizes) / sizeof(batch_sizes[0]); ++i)
+  {
+    batch_benchmark<void_signal> untracked(10, batch_sizes[i], false);
+    run(format_name("emit_batch/untracked/slots:10/batch:", batch_sizes[i]), untracked);
+    batch_benchmark<void_signal> tracked(10, batch_sizes[i], true);
+    run(format_name("emit_batch/tracked/slots:10/batch:", batch_sizes[i]), tracked);
+  }
+
+  const unsigned churn_counts[] = {0, 100, 1000};
+  for(unsigned i = 0; i < sizeof(churn_counts) / sizeof(churn_counts[0]); ++i)
+  {
+    churn_benchmark<void_signal> churn(churn_counts[i], false);
+    run(format_name("churn/connect_disconnect/slots:", churn_counts[i]), churn);
+    churn_benchmark<void_signal> churn_emit(churn_counts[i], true);
+    run(format_name("churn/connect_emit_disconnect/slots:", churn_counts[i]), churn_emit);
+    churn_benchmark<dummy_mutex_signal> dummy_churn(churn_counts[i], false);
+    run(format_name("churn/dummy_mutex/slots:", churn_counts[i]), dummy_churn);
+    churn_benchmark<single_threaded_signal> single_churn(churn_counts[i], false);
+    run(format_name("churn/single_threaded/slots:", churn_counts[i]), single_churn);
+    churn_benchmark<deferred_gc_signal> deferred_churn(churn_counts[i], true);
+    run(format_name("churn/deferred_gc/slots:", churn_counts[i]), deferred_churn);
+  }
+  // an rcu_mutex signal copies its slot list on every connect and disconnect
+  const unsigned copy_counts[] = {100, 1000, 10000};
+  for(unsigned i = 0; i < sizeof(copy_counts) / sizeof(copy_counts[0]); ++i)
+  {
+    churn_benchmark<rcu_signal> rcu_churn(copy_counts[i], false);
+    run(format_name("churn/rcu/slots:", copy_counts[i]), rcu_churn);
+    churn_benchmark<persistent_rcu_signal> persistent_churn(copy_counts[i], false);
+    run(format_name("churn/rcu_persistent/slots:", copy_counts[i]), persistent_churn);
+  }
+
+  wiring_benchmark<void_signal> wiring(300, false);
+  run("wiring/individual/slots:300", wiring);
+  wiring_benchmark<void_signal> batched_wiring(300, true);
+  run("wiring/batch/slots:300", batched_wiring);
+  wiring_benchmark<rcu_signal> rcu_wiring(300, false);
+  run("wiring/individual_rcu/slots:300", rcu_wiring);
+  wiring_benchmark<rcu_signal> batched_rcu_wiring(300, true);
+  run("wiring/batch_rcu/slots:300", batched_rcu_wiring);
+
+  for(unsigned i = 0; i < sizeof(churn_counts) / sizeof(churn_counts[0]); ++i)
+  {
+    disconnect_slot_benchmark<void_signal> disconnect_slot(churn_counts[i]);
+    run(format_name("disconnect_slot/slots:", churn_counts[i]), disconnect_slot);
+  }
+
+  const unsigned thread_counts[] = {1, 2, 4, 8};
+  for(unsigned i = 0; i < sizeof(thread_counts) / sizeof(thread_counts[0]); ++i)
+  {
+    contention_benchmark<void_signal> contention(10, thread_counts[i]);
+    run(format_name("contention/slots:10/threads:", thread_counts[i]), contention);
+  }
+
+#ifdef PARALLEL_COMBINER_AVAILABLE
+  const unsigned parallel_thread_counts[] = {1, 2, 4, 8, 16, 32, 64};
+  for(unsigned i = 0; i < sizeof(parallel_thread_counts) / sizeof(parallel_thread_counts[0]); ++i)
+  {
+    parallel_benchmark parallel(256, parallel_thread_counts[i]);
+    run(format_name("parallel/slots:256/threads:", parallel_thread_counts[i]), parallel);
+  }
+#endif
+  return 0;
+}
@@ -0,0 +1,184 @@
+// Tests for the garbage collection policies and boost::signals2::garbage_reaper
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#include <boost/signals2/garbage_reaper.hpp>
+#define BOOST_TEST_MODULE garbage_collection_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+template<typename Mutex, typename GarbageCollection>
+class signal_of
+{
+public:
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    Mutex, bs2::vector_slot_storage, std::allocator<void>, GarbageCollection> type;
+};
+
+typedef signal_of<bs2::mutex, bs2::eager_garbage_collection>::type eager_signal;
+typedef signal_of<bs2::mutex, bs2::deferred_garbage_collection>::type deferred_signal;
+typedef signal_of<bs2::rcu_mutex<bs2::mutex>, bs2::deferred_garbage_collection>::type deferred_rcu_signal;
+
+int calls = 0;
+
+void count_call(int)
+{
+  ++calls;
+}
+
+// disconnects every slot but one in each group of keep_one_in
+template<typename Signal>
+void connect_and_disconnect(Signal &sig, unsigned num_slots, unsigned keep_one_in = 2)
+{
+  std::vector<bs2::connection> connections;
+  for(unsigned i = 0; i < num_slots; ++i)
+    connections.push_back(sig.connect(&count_call));
+  for(unsigned i = 0; i < num_slots; ++i)
+  {
+    if(i % keep_one_in != 0) connections[i].disconnect();
+  }
+}
+
+template<typename Signal>
+void test_deferred(bool budgeted)
+{
+  Signal sig;
+  connect_and_disconnect(sig, 20);
+  calls = 0;
+  for(int i = 0; i < 10; ++i)
+    sig(0);
+  BOOST_CHECK_EQUAL(calls, 100);
+  // invocations left all the disconnected slots in place, and the budget
+  // limits how many slots are checked, unless the list has to be copied
+  if(budgeted)
+  {
+    BOOST_CHECK_EQUAL(sig.collect_garbage(4), 2u);
+    BOOST_CHECK_EQUAL(sig.collect_garbage(), 8u);
+  }else
+  {
+    BOOST_CHECK_EQUAL(sig.collect_garbage(4), 10u);
+  }
+  BOOST_CHECK_EQUAL(sig.collect_garbage(), 0u);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 10u);
+  calls = 0;
+  sig(0);
+  BOOST_CHECK_EQUAL(calls, 10);
+}
+
+void test_eager()
+{
+  eager_signal sig;
+  connect_and_disconnect(sig, 20, 4);
+  calls = 0;
+  sig(0);
+  BOOST_CHECK_EQUAL(calls, 5);
+  // the invocation found more disconnected slots than connected ones
+  BOOST_CHECK_EQUAL(sig.collect_garbage(), 0u);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 5u);
+}
+
+void test_tracked()
+{
+  deferred_signal sig;
+  boost::shared_ptr<int> tracked = boost::make_shared<int>(0);
+  bs2::connection conn = sig.connect(deferred_signal::slot_type(&count_call).track(tracked));
+  sig.connect(&count_call);
+  tracked.reset();
+  // expired slots are disconnected as they are collected
+  BOOST_CHECK_EQUAL(sig.collect_garbage(), 1u);
+  BOOST_CHECK(conn.connected() == false);
+}
+
+void test_connect_bounds_list()
+{
+  deferred_signal sig;
+  sig.connect(&count_call);
+  for(int i = 0; i < 1000; ++i)
+  {
+    bs2::connection conn = sig.connect(&count_call);
+    sig(0);
+    conn.disconnect();
+  }
+  // connecting compacts the list once disconnected slots outnumber connected ones
+  BOOST_CHECK(sig.collect_garbage() <= 2u);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+}
+
+deferred_signal *collecting_signal = 0;
+std::size_t collected_during_invocation = 0;
+
+void collect_from_slot(int)
+{
+  collected_during_invocation += collecting_signal->collect_garbage();
+}
+
+void test_collect_during_invocation()
+{
+  deferred_signal sig;
+  connect_and_disconnect(sig, 10);
+  sig.connect(&collect_from_slot);
+  collecting_signal = &sig;
+  calls = 0;
+  sig(0);
+  BOOST_CHECK_EQUAL(calls, 5);
+  BOOST_CHECK_EQUAL(collected_during_invocation, 5u);
+  calls = 0;
+  sig(0);
+  BOOST_CHECK_EQUAL(calls, 5);
+  BOOST_CHECK_EQUAL(collected_during_invocation, 5u);
+}
+
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_LAMBDAS) && \
+  !defined(BOOST_NO_CXX11_HDR_CHRONO) && !defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) && \
+  !defined(BOOST_NO_CXX11_HDR_THREAD) && !defined(BOOST_NO_CXX11_HDR_MUTEX) && \
+  !defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+void test_reaper()
+{
+  bs2::garbage_reaper reaper(std::chrono::milliseconds(1), 4);
+  BOOST_CHECK_EQUAL(reaper.budget(), 4u);
+  deferred_signal sig;
+  reaper.add(sig);
+  {
+    deferred_rcu_signal short_lived;
+    reaper.add(short_lived);
+    BOOST_CHECK_EQUAL(reaper.size(), 2u);
+  }
+  connect_and_disconnect(sig, 40);
+  // the reaper's thread forgets the destroyed signal
+  for(int i = 0; i < 1000 && reaper.size() > 1; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  BOOST_CHECK_EQUAL(reaper.size(), 1u);
+  // each collection removes at most the budget from each signal
+  std::size_t removed;
+  while((removed = reaper.collect()) > 0)
+    BOOST_CHECK(removed <= 4u);
+  BOOST_CHECK_EQUAL(sig.collect_garbage(), 0u);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 20u);
+}
+#else
+void test_reaper()
+{}
+#endif
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_deferred<deferred_signal>(true);
+  // invocations of an rcu_mutex signal always share its slot list
+  test_deferred<deferred_rcu_signal>(false);
+  test_eager();
+  test_tracked();
+  test_connect_bounds_list();
+  test_collect_during_invocation();
+  test_reaper();
+}
@@ -0,0 +1,158 @@
+// Tests for boost::signals2::inplace_function
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/config.hpp>
+#define BOOST_TEST_MODULE inplace_function_test
+#include <boost/test/included/unit_test.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+BOOST_AUTO_TEST_CASE(test_main)
+{
+}
+#else
+
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2.hpp>
+
+namespace bs2 = boost::signals2;
+using namespace boost::placeholders;
+
+int instances = 0;
+
+class counted_adder
+{
+public:
+  counted_adder(int amount): _amount(amount) {++instances;}
+  counted_adder(const counted_adder &other): _amount(other._amount) {++instances;}
+  ~counted_adder() {--instances;}
+  int operator()(int x) const {return x + _amount;}
+private:
+  int _amount;
+};
+
+class receiver
+{
+public:
+  receiver(): total(0) {}
+  void add(int x) {total += x;}
+  int total;
+};
+
+int negate(int x)
+{
+  return -x;
+}
+
+void test_function()
+{
+  typedef bs2::inplace_function<int (int)> function_type;
+  {
+    function_type f;
+    BOOST_CHECK(f.empty());
+    BOOST_CHECK(!f);
+    BOOST_CHECK_THROW(f(1), boost::bad_function_call);
+    int (*null_function)(int) = 0;
+    f = null_function;
+    BOOST_CHECK(f.empty());
+    f = &negate;
+    BOOST_CHECK(!f.empty());
+    BOOST_CHECK_EQUAL(f(2), -2);
+  }
+  {
+    function_type f = counted_adder(1);
+    BOOST_CHECK_EQUAL(instances, 1);
+    BOOST_CHECK_EQUAL(f(1), 2);
+    function_type g(f);
+    BOOST_CHECK_EQUAL(instances, 2);
+    BOOST_CHECK_EQUAL(g(2), 3);
+    function_type h(std::move(g));
+    BOOST_CHECK(g.empty());
+    BOOST_CHECK_EQUAL(instances, 2);
+    BOOST_CHECK_EQUAL(h(3), 4);
+    h = counted_adder(10);
+    BOOST_CHECK_EQUAL(instances, 2);
+    BOOST_CHECK_EQUAL(h(3), 13);
+    f.swap(h);
+    BOOST_CHECK_EQUAL(f(0), 10);
+    BOOST_CHECK_EQUAL(h(0), 1);
+    f.clear();
+    BOOST_CHECK(f.empty());
+    BOOST_CHECK_EQUAL(instances, 1);
+  }
+  BOOST_CHECK_EQUAL(instances, 0);
+  {
+    // a boost::function fits in the default capacity
+    boost::function<int (int)> bf(&negate);
+    function_type f(bf);
+    BOOST_CHECK_EQUAL(f(4), -4);
+  }
+  {
+    function_type f;
+    BOOST_CHECK(f.target_type() == boost::typeindex::type_id<void>());
+    BOOST_CHECK(f.target<int (*)(int)>() == 0);
+    f = &negate;
+    BOOST_CHECK(f.target_type() == boost::typeindex::type_id<int (*)(int)>());
+    BOOST_CHECK(*f.target<int (*)(int)>() == &negate);
+    BOOST_CHECK(f.target<counted_adder>() == 0);
+    BOOST_CHECK(f.contains(&negate));
+    f = counted_adder(1);
+    BOOST_CHECK(f.target<counted_adder>() != 0);
+    BOOST_CHECK(f.contains(&negate) == false);
+  }
+}
+
+void test_signal()
+{
+  using namespace bs2::keywords;
+  typedef bs2::inplace_function<void (int)> function_type;
+  typedef bs2::signal_type<void (int), slot_function_type<function_type> >::type signal_type;
+  BOOST_CHECK((boost::is_same<signal_type::slot_function_type, function_type>::value));
+
+  signal_type sig;
+  receiver r1;
+  boost::shared_ptr<receiver> r2 = boost::make_shared<receiver>();
+  bs2::connection c1 = sig.connect(boost::bind(&receiver::add, &r1, _1));
+  sig.connect(signal_type::slot_type(&receiver::add, r2.get(), _1).track(r2));
+  sig(2);
+  BOOST_CHECK_EQUAL(r1.total, 2);
+  BOOST_CHECK_EQUAL(r2->total, 2);
+  c1.disconnect();
+  sig(3);
+  BOOST_CHECK_EQUAL(r1.total, 2);
+  BOOST_CHECK_EQUAL(r2->total, 5);
+  r2.reset();
+  sig(4);
+  BOOST_CHECK(sig.empty());
+
+  typedef bs2::signal_type<int (int), slot_function_type<bs2::inplace_function<int (int)> > >::type
+    int_signal_type;
+  int_signal_type int_sig;
+  int_sig.connect(counted_adder(1));
+  int_sig.connect(&negate);
+  BOOST_CHECK_EQUAL(*int_sig(3), -3);
+
+  // disconnecting by the slot's function object
+  int_sig.disconnect(&negate);
+  BOOST_CHECK_EQUAL(int_sig.num_slots(), 1u);
+  BOOST_CHECK_EQUAL(*int_sig(3), 4);
+  int_sig.connect(1, &negate);
+  int_sig.disconnect(&negate);
+  BOOST_CHECK_EQUAL(int_sig.num_slots(), 1u);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_function();
+  test_signal();
+  BOOST_CHECK_EQUAL(instances, 0);
+}
+
+#endif
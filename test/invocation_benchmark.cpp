@@ -6,8 +6,11 @@
 // http://www.boost.org/LICENSE_1_0.txt)
 
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <boost/bind/bind.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/signals2.hpp>
 #include <boost/thread/thread.hpp>
 
@@ -34,27 +37,38 @@ int main(int argc, const char **argv)
 {
   if(argc < 3)
   {
-    std::cerr << "usage: " << argv[0] << " <num threads> <num connections>" << std::endl;
+    std::cerr << "usage: " << argv[0] << " <num threads> <num connections> [tracked]" << std::endl;
     return -1;
   }
   static const unsigned num_threads = std::strtol(argv[1], 0, 0);
   static const unsigned num_connections = std::strtol(argv[2], 0, 0);
+  // slots with tracked objects take the slower path through emission,
+  // which locks each connection
+  const bool tracked = argc > 3 && std::strcmp(argv[3], "tracked") == 0;
   boost::thread_group threads;
   signal_type sig;
+  boost::shared_ptr<int> tracked_object = boost::make_shared<int>(0);
 
-  std::cout << "Connecting " << num_connections << " connections to signal.\n";
+  std::cout << "Connecting " << num_connections << (tracked ? " tracked" : "") << " connections to signal.\n";
   unsigned i;
   for(i = 0; i < num_connections; ++i)
   {
-    sig.connect(&myslot);
+    signal_type::slot_type slot(&myslot);
+    if(tracked) slot.track(tracked_object);
+    sig.connect(slot);
   }
   const unsigned num_slot_invocations = 1000000;
   const unsigned signal_invocations_per_thread = num_slot_invocations / (num_threads * num_connections);
   std::cout << "Launching " << num_threads << " thread(s) to invoke signal " << signal_invocations_per_thread << " times per thread.\n";
+  const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
   for(i = 0; i < num_threads; ++i)
   {
     threads.create_thread(boost::bind(&thread_initial, &sig, signal_invocations_per_thread));
   }
   threads.join_all();
+  const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+  const double total_slot_invocations = double(signal_invocations_per_thread) * num_threads * num_connections;
+  std::cout << "Elapsed time: " << elapsed.total_milliseconds() << " ms\n";
+  std::cout << "Time per slot invocation: " << elapsed.total_nanoseconds() / total_slot_invocations << " ns\n";
   return 0;
 }
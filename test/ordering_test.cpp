@@ -84,14 +84,18 @@ void test_group_compare()
   BOOST_CHECK(sig() == 1);
 }
 
-BOOST_AUTO_TEST_CASE(test_main)
+template<typename SlotStorage>
+void test_ordering()
 {
-  using namespace std;
-  srand(static_cast<unsigned>(time(0)));
-
   std::vector<int> sortedValues;
-
-  boost::signals2::signal<void ()> sig;
+  valuesOutput.clear();
+  ungrouped1 = false;
+  ungrouped2 = false;
+  ungrouped3 = false;
+
+  boost::signals2::signal<void (), boost::signals2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void ()>, boost::function<void (const boost::signals2::connection &)>,
+    boost::signals2::mutex, SlotStorage> sig;
   sig.connect(write_ungrouped1());
   for (int i = 0; i < 100; ++i) {
 #ifdef BOOST_NO_STDC_NAMESPACE
@@ -124,5 +128,96 @@ BOOST_AUTO_TEST_CASE(test_main)
   BOOST_CHECK(ungrouped2);
   BOOST_CHECK(ungrouped3);
 
+  // disconnecting a group leaves the order of the rest alone
+  const int group = sortedValues.at(sortedValues.size() / 2);
+  sig.disconnect(group);
+  // leaving the ungrouped 17 and 42 at either end
+  sortedValues.erase(std::remove(sortedValues.begin() + 1, sortedValues.end() - 1, group), sortedValues.end() - 1);
+  valuesOutput.clear();
+  ungrouped1 = false;
+  ungrouped2 = false;
+  ungrouped3 = false;
+  sig();
+  std::cout << std::endl;
+  BOOST_CHECK(valuesOutput == sortedValues);
+}
+
+template<typename SlotStorage>
+void test_group_compare_storage()
+{
+  boost::signals2::signal
+  <
+    int (),
+    boost::signals2::last_value<int>,
+    int,
+    std::greater< int >,
+    boost::function<int ()>,
+    boost::function<int (const boost::signals2::connection &)>,
+    boost::signals2::mutex,
+    SlotStorage
+  > sig;
+
+  sig.connect( 1, boost::bind( &return_argument, 1) );
+  sig.connect( 2, boost::bind( &return_argument, 2) );
+
+  BOOST_CHECK(sig() == 1);
+}
+
+template<typename SlotStorage>
+void test_no_groups()
+{
+  boost::signals2::signal<void (), boost::signals2::optional_last_value<void>,
+    boost::signals2::no_groups, std::less<boost::signals2::no_groups>,
+    boost::function<void ()>, boost::function<void (const boost::signals2::connection &)>,
+    boost::signals2::mutex, SlotStorage> sig;
+  std::vector<int> expected;
+  std::vector<boost::signals2::connection> connections;
+  for(int i = 0; i < 10; ++i)
+  {
+    connections.push_back(sig.connect(emit_int(i)));
+    expected.push_back(i);
+  }
+  sig.connect(emit_int(-1), boost::signals2::at_front);
+  expected.insert(expected.begin(), -1);
+  for(int i = 0; i < 10; i += 3)
+  {
+    connections.at(i).disconnect();
+    expected.erase(std::remove(expected.begin(), expected.end(), i), expected.end());
+  }
+  BOOST_CHECK(sig.num_slots() == expected.size());
+  ungrouped1 = false;
+  ungrouped2 = false;
+  ungrouped3 = false;
+  valuesOutput.clear();
+  sig();
+  std::cout << std::endl;
+  BOOST_CHECK(valuesOutput == expected);
+  sig.disconnect_all_slots();
+  BOOST_CHECK(sig.empty());
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  using namespace std;
+  srand(static_cast<unsigned>(time(0)));
+
+  test_ordering<boost::signals2::vector_slot_storage>();
+  test_ordering<boost::signals2::list_slot_storage>();
+  test_ordering<boost::signals2::ungrouped_slot_storage>();
+  test_ordering<boost::signals2::persistent_slot_storage>();
+  test_ordering<boost::signals2::small_slot_storage<> >();
+  test_ordering<boost::signals2::small_slot_storage<1> >();
+
   test_group_compare();
+  test_group_compare_storage<boost::signals2::list_slot_storage>();
+  test_group_compare_storage<boost::signals2::ungrouped_slot_storage>();
+  test_group_compare_storage<boost::signals2::persistent_slot_storage>();
+  test_group_compare_storage<boost::signals2::small_slot_storage<> >();
+
+  test_no_groups<boost::signals2::vector_slot_storage>();
+  test_no_groups<boost::signals2::list_slot_storage>();
+  test_no_groups<boost::signals2::ungrouped_slot_storage>();
+  test_no_groups<boost::signals2::persistent_slot_storage>();
+  test_no_groups<boost::signals2::small_slot_storage<> >();
+  test_no_groups<boost::signals2::small_slot_storage<1> >();
 }
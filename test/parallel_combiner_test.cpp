@@ -0,0 +1,191 @@
+// Tests for boost::signals2::parallel_combiner
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2/parallel_combiner.hpp>
+#define BOOST_TEST_MODULE parallel_combiner_test
+#include <boost/test/included/unit_test.hpp>
+
+#if defined(BOOST_NO_CXX11_RVALUE_REFERENCES) || defined(BOOST_NO_CXX11_LAMBDAS) || \
+  defined(BOOST_NO_CXX11_HDR_ATOMIC) || defined(BOOST_NO_CXX11_HDR_FUNCTIONAL) || \
+  defined(BOOST_NO_CXX11_HDR_THREAD) || defined(BOOST_NO_CXX11_HDR_MUTEX) || \
+  defined(BOOST_NO_CXX11_HDR_CONDITION_VARIABLE)
+BOOST_AUTO_TEST_CASE(test_main)
+{
+}
+#else
+
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/signals2.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+using namespace boost::placeholders;
+
+// collects the slots' results, in the order it is given them
+class collect
+{
+public:
+  typedef std::vector<int> result_type;
+  template<typename InputIterator>
+  result_type operator()(InputIterator first, InputIterator last) const
+  {
+    result_type results;
+    for(; first != last; ++first)
+    {
+      try
+      {
+        results.push_back(*first);
+      }
+      catch(const bs2::expired_slot &)
+      {}
+    }
+    return results;
+  }
+};
+
+typedef bs2::signal<int (int), bs2::parallel_combiner<collect> > signal_type;
+
+std::atomic<int> calls(0);
+
+int multiply(int x, int y)
+{
+  ++calls;
+  // enough work for the threads to overlap
+  volatile int sink = 0;
+  for(int i = 0; i < 1000; ++i) sink = sink + i;
+  return x * y;
+}
+
+int throw_on_negative(int x)
+{
+  if(x < 0) throw std::runtime_error("negative");
+  return x;
+}
+
+void test_results()
+{
+  signal_type sig(bs2::parallel_combiner<collect>(4));
+  BOOST_CHECK(sig(1).empty());
+  for(int i = 0; i < 100; ++i)
+    sig.connect(boost::bind(&multiply, i, _1));
+  for(int round = 0; round < 20; ++round)
+  {
+    calls = 0;
+    std::vector<int> results = sig(2);
+    BOOST_CHECK_EQUAL(calls.load(), 100);
+    BOOST_REQUIRE_EQUAL(results.size(), 100u);
+    // results are passed on in slot order
+    for(int i = 0; i < 100; ++i)
+      BOOST_CHECK_EQUAL(results[i], 2 * i);
+  }
+}
+
+void test_blocked_and_tracked()
+{
+  signal_type sig(bs2::parallel_combiner<collect>(3, collect(), 2));
+  std::vector<bs2::connection> connections;
+  std::vector<boost::shared_ptr<int> > tracked;
+  for(int i = 0; i < 30; ++i)
+  {
+    tracked.push_back(boost::make_shared<int>(i));
+    connections.push_back(sig.connect(
+      signal_type::slot_type(&multiply, i, _1).track(tracked.back())));
+  }
+  bs2::shared_connection_block block(connections[5]);
+  tracked[7].reset();
+  tracked[20].reset();
+  connections[25].disconnect();
+  std::vector<int> results = sig(1);
+  BOOST_CHECK_EQUAL(results.size(), 26u);
+  BOOST_CHECK(std::find(results.begin(), results.end(), 5) == results.end());
+  BOOST_CHECK(std::find(results.begin(), results.end(), 20) == results.end());
+  BOOST_CHECK(connections[7].connected() == false);
+  BOOST_CHECK(connections[5].connected());
+  BOOST_CHECK_EQUAL(sig.num_slots(), 27u);
+}
+
+void test_exceptions()
+{
+  signal_type sig(bs2::parallel_combiner<collect>(2));
+  for(int i = 0; i < 10; ++i)
+    sig.connect(&throw_on_negative);
+  BOOST_CHECK_EQUAL(sig(1).size(), 10u);
+  BOOST_CHECK_THROW(sig(-1), std::runtime_error);
+  BOOST_CHECK_EQUAL(sig(1).size(), 10u);
+}
+
+void test_executors()
+{
+  // an inline executor calls every chunk on the emitting thread
+  boost::shared_ptr<bs2::inline_executor> inline_executor = boost::make_shared<bs2::inline_executor>();
+  signal_type sig(bs2::parallel_combiner<collect>(inline_executor, 4));
+  for(int i = 0; i < 10; ++i)
+    sig.connect(boost::bind(&multiply, i, _1));
+  BOOST_CHECK_EQUAL(sig(3).size(), 10u);
+
+  boost::shared_ptr<bs2::thread_pool_executor> pool = boost::make_shared<bs2::thread_pool_executor>(2);
+  sig.set_combiner(bs2::parallel_combiner<collect>(pool, 3));
+  std::vector<int> results = sig(3);
+  BOOST_REQUIRE_EQUAL(results.size(), 10u);
+  BOOST_CHECK_EQUAL(results[9], 27);
+
+  // batches aren't shared out, but still reach the inner combiner
+  std::vector<int> batch(2, 1);
+  std::vector<std::vector<int> > batch_results;
+  sig.emit_batch(batch.begin(), batch.end(), std::back_inserter(batch_results));
+  BOOST_REQUIRE_EQUAL(batch_results.size(), 2u);
+  BOOST_CHECK_EQUAL(batch_results[1].size(), 10u);
+
+  // a single thread calls the slots in the ordinary way
+  sig.set_combiner(bs2::parallel_combiner<collect>(1));
+  BOOST_CHECK_EQUAL(sig(3).size(), 10u);
+}
+
+void test_slot_counts()
+{
+  // the slots found disconnected outnumber the connected ones by one, which
+  // is enough for the invocation to clean them up, unless a slot is counted twice
+  signal_type sig(bs2::parallel_combiner<collect>(2));
+  std::vector<bs2::connection> connections;
+  for(int i = 0; i < 7; ++i)
+    connections.push_back(sig.connect(boost::bind(&multiply, i, _1)));
+  for(int i = 1; i < 5; ++i)
+    connections[i].disconnect();
+  std::vector<int> results = sig(1);
+  BOOST_REQUIRE_EQUAL(results.size(), 3u);
+  BOOST_CHECK_EQUAL(results[0], 0);
+  BOOST_CHECK_EQUAL(results[1], 5);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 3u);
+  BOOST_CHECK_EQUAL(sig.collect_garbage(), 0u);
+}
+
+void test_void_signal()
+{
+  bs2::signal<void (int), bs2::parallel_combiner<bs2::optional_last_value<void> > > sig;
+  calls = 0;
+  for(int i = 0; i < 50; ++i)
+    sig.connect(boost::bind(&multiply, i, _1));
+  sig(1);
+  BOOST_CHECK_EQUAL(calls.load(), 50);
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_results();
+  test_blocked_and_tracked();
+  test_exceptions();
+  test_executors();
+  test_slot_counts();
+  test_void_signal();
+}
+
+#endif
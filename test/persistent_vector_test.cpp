@@ -0,0 +1,232 @@
+// Tests for the slot list of persistent_slot_storage, whose copies share
+// their storage
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#include <boost/signals2/detail/persistent_vector.hpp>
+#define BOOST_TEST_MODULE persistent_vector_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+namespace detail = boost::signals2::detail;
+
+typedef detail::group_key<int>::type group_key_type;
+typedef detail::group_key_less<int, std::less<int> > group_key_compare_type;
+
+class item
+{
+public:
+  item(int id, const group_key_type &key): id(id), key(key), removed(false)
+  {}
+  const group_key_type & group_key() const {return key;}
+  int id;
+  group_key_type key;
+  bool removed;
+};
+typedef boost::shared_ptr<item> item_pointer;
+typedef detail::persistent_vector<int, std::less<int>, item_pointer> list_type;
+
+// the order slots should be in, kept the simple way
+class model
+{
+public:
+  void push_back(const item_pointer &value)
+  {
+    _items.insert(std::upper_bound(_items.begin(), _items.end(), value, key_less()), value);
+  }
+  void push_front(const item_pointer &value)
+  {
+    _items.insert(std::lower_bound(_items.begin(), _items.end(), value, key_less()), value);
+  }
+  void remove_removed()
+  {
+    std::vector<item_pointer> items;
+    for(std::size_t i = 0; i < _items.size(); ++i)
+      if(_items[i]->removed == false) items.push_back(_items[i]);
+    _items.swap(items);
+  }
+  std::vector<int> ids() const
+  {
+    std::vector<int> result;
+    for(std::size_t i = 0; i < _items.size(); ++i)
+      result.push_back(_items[i]->id);
+    return result;
+  }
+private:
+  class key_less
+  {
+  public:
+    bool operator()(const item_pointer &a, const item_pointer &b) const
+    {
+      return group_key_compare_type()(a->key, b->key);
+    }
+  };
+  std::vector<item_pointer> _items;
+};
+
+std::vector<int> ids(list_type &list)
+{
+  std::vector<int> result;
+  for(list_type::iterator it = list.begin(); it != list.end(); ++it)
+    result.push_back((*it)->id);
+  BOOST_CHECK_EQUAL(result.size(), list.size());
+  return result;
+}
+
+group_key_type random_key()
+{
+  switch(std::rand() % 4)
+  {
+  case 0:
+    return group_key_type(detail::front_ungrouped_slots, boost::optional<int>());
+  case 1:
+    return group_key_type(detail::back_ungrouped_slots, boost::optional<int>());
+  default:
+    return group_key_type(detail::grouped_slots, std::rand() % 10);
+  }
+}
+
+class is_removed
+{
+public:
+  bool operator()(const item_pointer &value) const {return value->removed;}
+};
+
+BOOST_AUTO_TEST_CASE(test_against_model)
+{
+  std::srand(42);
+  list_type list((group_key_compare_type()));
+  model expected;
+  std::vector<list_type> copies;
+  std::vector<std::vector<int> > copy_ids;
+  for(int i = 0; i < 3000; ++i)
+  {
+    const int operation = std::rand() % 10;
+    if(operation < 6)
+    {
+      item_pointer value = boost::make_shared<item>(i, random_key());
+      if(std::rand() % 2)
+      {
+        list.push_back(value->key, value);
+        expected.push_back(value);
+      }else
+      {
+        list.push_front(value->key, value);
+        expected.push_front(value);
+      }
+    }else if(operation < 9 && list.size() > 0)
+    {
+      // erase one slot, like the signal's incremental cleanup
+      list_type::iterator it = list.begin();
+      for(int n = std::rand() % static_cast<int>(list.size()); n > 0; --n) ++it;
+      (*it)->removed = true;
+      list.erase((*it)->key, it);
+      expected.remove_removed();
+    }else
+    {
+      std::vector<int> current = ids(list);
+      for(std::size_t j = 0; j < current.size(); j += 3)
+      {
+        list_type::iterator it = list.begin();
+        for(std::size_t n = 0; n < j; ++n) ++it;
+        (*it)->removed = true;
+      }
+      list.remove_if(is_removed());
+      expected.remove_removed();
+    }
+    BOOST_REQUIRE(ids(list) == expected.ids());
+    // copies must not see later modifications of the list
+    if(i % 100 == 0)
+    {
+      copies.push_back(list);
+      copy_ids.push_back(ids(list));
+    }
+  }
+  for(std::size_t i = 0; i < copies.size(); ++i)
+    BOOST_CHECK(ids(copies[i]) == copy_ids[i]);
+  // nor the list modifications of its copies
+  const std::vector<int> final_ids = ids(list);
+  for(std::size_t i = 0; i < copies.size(); ++i)
+  {
+    copies[i].clear();
+    item_pointer value = boost::make_shared<item>(-1, random_key());
+    copies[i].push_back(value->key, value);
+  }
+  BOOST_CHECK(ids(list) == final_ids);
+}
+
+BOOST_AUTO_TEST_CASE(test_iterator_across_modifications)
+{
+  list_type list((group_key_compare_type()));
+  const group_key_type back(detail::back_ungrouped_slots, boost::optional<int>());
+  for(int i = 0; i < 200; ++i)
+    list.push_back(back, boost::make_shared<item>(i, back));
+  list_type::iterator it = list.begin();
+  for(int i = 0; i < 150; ++i) ++it;
+  // an iterator sees whichever slot moves into its position
+  list_type::iterator first = list.begin();
+  list.erase(back, first);
+  BOOST_CHECK_EQUAL((*it)->id, 151);
+  list.push_front(back, boost::make_shared<item>(-1, back));
+  BOOST_CHECK_EQUAL((*it)->id, 150);
+  ++it;
+  BOOST_CHECK_EQUAL((*it)->id, 151);
+  it = list.erase(back, it);
+  BOOST_CHECK_EQUAL((*it)->id, 152);
+}
+
+int calls = 0;
+
+void count_call()
+{
+  ++calls;
+}
+
+typedef bs2::signal<void (), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void ()>, boost::function<void (const bs2::connection &)>,
+  bs2::mutex, bs2::persistent_slot_storage> signal_type;
+
+// connects and disconnects slots while the signal is being invoked, so the
+// signal works on copies of its slot list
+void rewire(signal_type &sig, std::vector<bs2::connection> &connections)
+{
+  for(int i = 0; i < 20; ++i)
+    connections.push_back(sig.connect(i % 5, &count_call));
+  for(std::size_t i = 0; i < connections.size(); i += 4)
+    connections[i].disconnect();
+}
+
+BOOST_AUTO_TEST_CASE(test_signal)
+{
+  signal_type sig;
+  std::vector<bs2::connection> connections;
+  for(int i = 0; i < 300; ++i)
+    connections.push_back(sig.connect(&count_call));
+  bs2::connection rewiring = sig.connect(boost::bind(&rewire, boost::ref(sig), boost::ref(connections)),
+    bs2::at_front);
+  std::size_t expected = sig.num_slots() - 1;
+  for(int i = 0; i < 10; ++i)
+  {
+    calls = 0;
+    sig();
+    // the slots connected by this invocation weren't called by it, but the
+    // ones it disconnected before reaching them weren't either
+    BOOST_CHECK(calls <= static_cast<int>(expected));
+    expected = sig.num_slots() - 1;
+  }
+  rewiring.disconnect();
+  calls = 0;
+  sig();
+  BOOST_CHECK_EQUAL(calls, static_cast<int>(sig.num_slots()));
+}
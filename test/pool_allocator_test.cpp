@@ -0,0 +1,238 @@
+// Tests for the Allocator parameter of signal and for boost::signals2::pool_allocator
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#define BOOST_TEST_MODULE pool_allocator_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/bind/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/thread/thread.hpp>
+#include <memory>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+
+// an allocator which counts the objects it has outstanding
+template<typename T>
+class counting_allocator
+{
+public:
+  typedef T value_type;
+  typedef T * pointer;
+  typedef const T * const_pointer;
+  typedef T & reference;
+  typedef const T & const_reference;
+  typedef std::size_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  template<typename U> struct rebind
+  {
+    typedef counting_allocator<U> other;
+  };
+
+  explicit counting_allocator(long *count): _count(count)
+  {}
+  template<typename U>
+  counting_allocator(const counting_allocator<U> &other): _count(other._count)
+  {}
+  pointer allocate(size_type n, const void * = 0)
+  {
+    ++*_count;
+    return std::allocator<T>().allocate(n);
+  }
+  void deallocate(pointer p, size_type n)
+  {
+    --*_count;
+    std::allocator<T>().deallocate(p, n);
+  }
+  size_type max_size() const {return std::allocator<T>().max_size();}
+  void construct(pointer p, const T &value) {new(p) T(value);}
+  void destroy(pointer p) {p->~T();}
+
+  long *_count;
+};
+template<typename T, typename U>
+bool operator==(const counting_allocator<T> &a, const counting_allocator<U> &b)
+{
+  return a._count == b._count;
+}
+template<typename T, typename U>
+bool operator!=(const counting_allocator<T> &a, const counting_allocator<U> &b)
+{
+  return a._count != b._count;
+}
+
+int total = 0;
+
+void add(int x)
+{
+  total += x;
+}
+
+class receiver
+{
+public:
+  receiver(): total(0) {}
+  void add(int x) {total += x;}
+  int total;
+};
+
+void test_signal_allocator()
+{
+  typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+    boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+    bs2::mutex, bs2::vector_slot_storage, counting_allocator<char> > signal_type;
+  long count = 0;
+  {
+    const counting_allocator<char> alloc(&count);
+    signal_type sig(signal_type::combiner_type(), signal_type::group_compare_type(), alloc);
+    BOOST_CHECK(count > 0);
+    const long empty_count = count;
+    bs2::connection c1 = sig.connect(&add);
+    BOOST_CHECK(count > empty_count);
+    const long one_count = count;
+    sig.connect(1, &add);
+    BOOST_CHECK(count > one_count);
+    total = 0;
+    sig(2);
+    BOOST_CHECK_EQUAL(total, 4);
+    c1.disconnect();
+    sig(1);
+    BOOST_CHECK_EQUAL(total, 5);
+  }
+  BOOST_CHECK_EQUAL(count, 0);
+}
+
+typedef bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+  bs2::mutex, bs2::vector_slot_storage, bs2::pool_allocator<void> > pool_signal_type;
+
+void test_pool_allocator()
+{
+  {
+    bs2::pool_allocator<int> alloc;
+    int *p = alloc.allocate(1);
+    *p = 1;
+    int *q = alloc.allocate(1);
+    BOOST_CHECK(p != q);
+    alloc.deallocate(p, 1);
+    // the node just freed is reused first
+    BOOST_CHECK(alloc.allocate(1) == p);
+    alloc.deallocate(p, 1);
+    alloc.deallocate(q, 1);
+    int *array = alloc.allocate(100);
+    array[99] = 1;
+    alloc.deallocate(array, 100);
+    BOOST_CHECK(alloc == bs2::pool_allocator<double>());
+  }
+  {
+    std::vector<int, bs2::pool_allocator<int> > v;
+    for(int i = 0; i < 1000; ++i) v.push_back(i);
+    BOOST_CHECK_EQUAL(v[999], 999);
+  }
+
+  pool_signal_type sig;
+  receiver r1;
+  boost::shared_ptr<receiver> r2 = boost::make_shared<receiver>();
+  bs2::connection c1 = sig.connect(boost::bind(&receiver::add, &r1, boost::placeholders::_1));
+  sig.connect(pool_signal_type::slot_type(&receiver::add, r2.get(), boost::placeholders::_1).track(r2));
+  sig(2);
+  BOOST_CHECK_EQUAL(r1.total, 2);
+  BOOST_CHECK_EQUAL(r2->total, 2);
+  c1.disconnect();
+  r2.reset();
+  sig(3);
+  BOOST_CHECK_EQUAL(r1.total, 2);
+  BOOST_CHECK(sig.empty());
+}
+
+// connections made on one thread and released on another
+void churn(pool_signal_type &sig, unsigned iterations)
+{
+  for(unsigned i = 0; i < iterations; ++i)
+  {
+    bs2::connection c = sig.connect(&add);
+    sig.connect(&add);
+    c.disconnect();
+    if(i % 16 == 0) sig.disconnect_all_slots();
+  }
+}
+
+void test_threads()
+{
+  pool_signal_type sig;
+  std::vector<boost::shared_ptr<boost::thread> > threads;
+  for(unsigned i = 0; i < 4; ++i)
+  {
+    threads.push_back(boost::make_shared<boost::thread>(boost::bind(&churn, boost::ref(sig), 2000)));
+  }
+  for(unsigned i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+  }
+  sig.disconnect_all_slots();
+  BOOST_CHECK(sig.empty());
+}
+
+// destroyed during exit, after the main thread's node caches
+pool_signal_type static_signal;
+
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+typedef bs2::detail::thread_node_cache<bs2::detail::pool_node_size<int>::value> int_node_cache;
+bool cache_gone_at_thread_exit = false;
+
+// a thread_local made before its thread's node caches, so destroyed after them
+class thread_exit_signal
+{
+public:
+  ~thread_exit_signal()
+  {
+    cache_gone_at_thread_exit = int_node_cache::instance() == 0;
+    sig.disconnect_all_slots();
+    // nodes still come and go through the global pool
+    bs2::pool_allocator<int> alloc;
+    int *p = alloc.allocate(1);
+    alloc.deallocate(p, 1);
+    alloc.deallocate(_node, 1);
+  }
+  void connect()
+  {
+    _node = bs2::pool_allocator<int>().allocate(1);
+    for(int i = 0; i < 10; ++i)
+      sig.connect(&add);
+  }
+  pool_signal_type sig;
+private:
+  int *_node;
+};
+
+void connect_thread_exit_signal()
+{
+  static thread_local thread_exit_signal holder;
+  holder.connect();
+}
+#endif
+
+void test_teardown()
+{
+  for(int i = 0; i < 10; ++i)
+    static_signal.connect(&add);
+#ifndef BOOST_NO_CXX11_THREAD_LOCAL
+  boost::thread thread(&connect_thread_exit_signal);
+  thread.join();
+  BOOST_CHECK(cache_gone_at_thread_exit);
+#endif
+}
+
+BOOST_AUTO_TEST_CASE(test_main)
+{
+  test_signal_allocator();
+  test_pool_allocator();
+  test_threads();
+  test_teardown();
+}
@@ -109,4 +109,34 @@ BOOST_AUTO_TEST_CASE(test_main)
     s0();
     BOOST_CHECK(test_output.str() == "123");
   }
+
+  {
+    // independent blocks on the same connection
+    boost::signals2::shared_connection_block block1(connections.at(1));
+    boost::signals2::shared_connection_block block2(connections.at(1));
+    BOOST_CHECK(connections.at(1).blocked());
+    block1.unblock();
+    BOOST_CHECK(connections.at(1).blocked());
+    test_output.str("");
+    s0();
+    BOOST_CHECK(test_output.str() == "023");
+    block2.unblock();
+    BOOST_CHECK(connections.at(1).blocked() == false);
+    test_output.str("");
+    s0();
+    BOOST_CHECK(test_output.str() == "0123");
+  }
+
+  {
+    // block outliving its signal
+    boost::signals2::shared_connection_block block;
+    {
+      boost::signals2::signal<void ()> s1;
+      block = boost::signals2::shared_connection_block(s1.connect(test_slot(0)));
+      BOOST_CHECK(block.connection().blocked());
+    }
+    BOOST_CHECK(block.blocking());
+    block.unblock();
+    BOOST_CHECK(block.blocking() == false);
+  }
 }
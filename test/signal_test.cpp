@@ -13,11 +13,14 @@
 #include <boost/bind/bind.hpp>
 #include <boost/optional.hpp>
 #include <boost/signals2.hpp>
+#include <boost/tuple/tuple.hpp>
 #define BOOST_TEST_MODULE signal_test
 #include <boost/test/included/unit_test.hpp>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <typeinfo>
+#include <vector>
 
 using namespace boost::placeholders;
 
@@ -44,6 +47,21 @@ struct max_or_default {
   }
 };
 
+// counts the invocations it combined
+struct counting_combiner {
+  typedef int result_type;
+  counting_combiner(): invocations(0) {}
+  template<typename InputIterator>
+  int operator()(InputIterator first, InputIterator last)
+  {
+    ++invocations;
+    int count = 0;
+    for (; first != last; ++first) ++count;
+    return count;
+  }
+  int invocations;
+};
+
 struct make_int {
   make_int(int n, int cn) : N(n), CN(cn) {}
 
@@ -352,6 +370,267 @@ void test_move()
 #endif // !defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
 }
 
+static int
+return_one()
+{
+  return 1;
+}
+
+static void
+test_num_slots()
+{
+  typedef boost::signals2::signal<int ()> signal_type;
+  signal_type sig;
+  BOOST_CHECK(sig.empty());
+  BOOST_CHECK_EQUAL(sig.num_slots(), 0u);
+  boost::signals2::connection c1 = sig.connect(&return_one);
+  boost::signals2::connection c2 = sig.connect(0, &return_one);
+  BOOST_CHECK(sig.empty() == false);
+  BOOST_CHECK_EQUAL(sig.num_slots(), 2u);
+  {
+    // blocked slots are still connected
+    boost::signals2::shared_connection_block block(c1);
+    BOOST_CHECK_EQUAL(sig.num_slots(), 2u);
+  }
+  c1.disconnect();
+  c1.disconnect();
+  BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+  {
+    boost::shared_ptr<int> tracked(new int(0));
+    sig.connect(signal_type::slot_type(&return_one).track(tracked));
+    BOOST_CHECK_EQUAL(sig.num_slots(), 2u);
+    c2.disconnect();
+    BOOST_CHECK(sig.empty() == false);
+  }
+  // the tracked object expiring disconnects its slot without an invocation
+  BOOST_CHECK(sig.empty());
+  BOOST_CHECK_EQUAL(sig.num_slots(), 0u);
+  {
+    boost::signals2::scoped_connection c3(sig.connect(&return_one));
+    sig.connect(1, &return_one);
+    sig.connect(1, &return_one);
+    BOOST_CHECK_EQUAL(sig.num_slots(), 3u);
+    sig.disconnect(1);
+    BOOST_CHECK_EQUAL(sig.num_slots(), 1u);
+  }
+  BOOST_CHECK(sig.empty());
+  sig.connect(&return_one);
+  sig.connect(&return_one);
+  sig.disconnect_all_slots();
+  BOOST_CHECK(sig.empty());
+  BOOST_CHECK_EQUAL(sig.num_slots(), 0u);
+}
+
+std::vector<int> batch_log;
+
+void log_value(int x)
+{
+  batch_log.push_back(x);
+}
+
+void log_negated(int x)
+{
+  batch_log.push_back(-x);
+}
+
+int add_values(int x, int y)
+{
+  return x + y;
+}
+
+static void
+test_emit_batch()
+{
+  {
+    boost::signals2::signal<void (int)> sig;
+    boost::signals2::connection c1 = sig.connect(&log_value);
+    boost::signals2::connection c2 = sig.connect(&log_negated);
+    std::vector<int> batch;
+    batch.push_back(1);
+    batch.push_back(2);
+    batch.push_back(3);
+    batch_log.clear();
+    sig.emit_batch(batch.begin(), batch.end());
+    // every slot sees each set of arguments before any slot sees the next
+    const int expected[] = {1, -1, 2, -2, 3, -3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(batch_log.begin(), batch_log.end(), expected, expected + 6);
+    {
+      boost::signals2::shared_connection_block block(c2);
+      batch_log.clear();
+      sig.emit_batch(batch.begin(), batch.end());
+      BOOST_CHECK_EQUAL(batch_log.size(), 3u);
+    }
+    c1.disconnect();
+    batch_log.clear();
+    sig.emit_batch(batch.begin(), batch.begin());
+    BOOST_CHECK(batch_log.empty());
+    sig.emit_batch(batch.begin(), batch.end());
+    BOOST_CHECK_EQUAL(batch_log.size(), 3u);
+    BOOST_CHECK_EQUAL(batch_log.back(), -3);
+  }
+  {
+    // tracked objects are held for the whole batch
+    boost::signals2::signal<void (int)> sig;
+    boost::shared_ptr<int> tracked(new int(0));
+    sig.connect(boost::signals2::signal<void (int)>::slot_type(&log_value).track(tracked));
+    std::vector<int> batch(10, 1);
+    batch_log.clear();
+    sig.emit_batch(batch.begin(), batch.end());
+    BOOST_CHECK_EQUAL(batch_log.size(), 10u);
+    tracked.reset();
+    sig.emit_batch(batch.begin(), batch.end());
+    BOOST_CHECK_EQUAL(batch_log.size(), 10u);
+    BOOST_CHECK(sig.empty());
+  }
+  {
+    boost::signals2::signal<int (int, int), max_or_default<int> > sig;
+    sig.connect(&add_values);
+    sig.connect(boost::bind(&add_values, _1, 10));
+    std::vector<boost::tuple<int, int> > batch;
+    batch.push_back(boost::make_tuple(1, 2));
+    batch.push_back(boost::make_tuple(3, -4));
+    std::vector<int> results;
+    sig.emit_batch(batch.begin(), batch.end(), std::back_inserter(results));
+    BOOST_REQUIRE_EQUAL(results.size(), 2u);
+    BOOST_CHECK_EQUAL(results[0], 11);
+    BOOST_CHECK_EQUAL(results[1], 13);
+#ifndef BOOST_NO_CXX11_HDR_TUPLE
+    std::vector<std::tuple<int, int> > std_batch;
+    std_batch.push_back(std::make_tuple(5, 6));
+    const std::vector<std::tuple<int, int> > &const_batch = std_batch;
+    results.clear();
+    sig.emit_batch(const_batch.begin(), const_batch.end(), std::back_inserter(results));
+    BOOST_REQUIRE_EQUAL(results.size(), 1u);
+    BOOST_CHECK_EQUAL(results[0], 15);
+#endif
+  }
+  {
+    boost::signals2::signal<int ()> sig;
+    sig.connect(&return_one);
+    std::vector<int> batch(3);
+    std::vector<boost::optional<int> > results;
+    sig.emit_batch(batch.begin(), batch.end(), std::back_inserter(results));
+    BOOST_REQUIRE_EQUAL(results.size(), 3u);
+    BOOST_CHECK_EQUAL(results[2].get(), 1);
+  }
+}
+
+static void
+test_lazy_construction()
+{
+  {
+    typedef boost::signals2::signal<int ()> signal_type;
+    signal_type sig;
+#ifndef BOOST_NO_CXX11_DECLTYPE
+    // nothing is allocated until the signal is connected to
+    BOOST_CHECK(sig.null());
+#endif
+    BOOST_CHECK(sig.empty());
+    BOOST_CHECK_EQUAL(sig.num_slots(), 0u);
+    BOOST_CHECK(!sig());
+    const signal_type &const_sig = sig;
+    BOOST_CHECK(!const_sig());
+    sig.disconnect_all_slots();
+    sig.disconnect(0);
+    BOOST_CHECK_EQUAL(sig.collect_garbage(), 0u);
+    signal_type other;
+    BOOST_CHECK(sig == sig);
+    BOOST_CHECK(!(sig == other));
+    sig.connect(&return_one);
+    BOOST_CHECK(sig.null() == false);
+    BOOST_CHECK_EQUAL(sig().get(), 1);
+  }
+  {
+    boost::signals2::signal<int (), boost::signals2::last_value<int> > sig;
+    BOOST_CHECK_THROW(sig(), boost::signals2::no_slots_error);
+  }
+  {
+    boost::signals2::signal<int (), max_or_default<int> > sig;
+    BOOST_CHECK_EQUAL(sig(), 0);
+  }
+  {
+    // a combiner with state is never a throwaway, so invoking creates the internals
+    boost::signals2::signal<int (), counting_combiner> sig;
+    BOOST_CHECK_EQUAL(sig(), 0);
+    BOOST_CHECK(sig.null() == false);
+    BOOST_CHECK_EQUAL(sig(), 0);
+    BOOST_CHECK_EQUAL(sig.combiner().invocations, 2);
+    const boost::signals2::signal<int (), counting_combiner> const_sig;
+    BOOST_CHECK_EQUAL(const_sig(), 0);
+    BOOST_CHECK_EQUAL(const_sig.combiner().invocations, 1);
+  }
+  {
+    // a signal connected to another, or tracked, before either has slots
+    typedef boost::signals2::signal<void (int)> signal_type;
+    signal_type outer;
+    signal_type inner;
+    outer.connect(inner);
+    signal_type::slot_type slot(&log_value);
+    signal_type tracking;
+    tracking.connect(slot.track(inner));
+    BOOST_CHECK_EQUAL(outer.num_slots(), 1u);
+    BOOST_CHECK_EQUAL(tracking.num_slots(), 1u);
+    batch_log.clear();
+    outer(1);
+    BOOST_CHECK(batch_log.empty());
+    inner.connect(&log_negated);
+    outer(2);
+    tracking(3);
+    const int expected[] = {-2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(batch_log.begin(), batch_log.end(), expected, expected + 2);
+  }
+#if !defined(BOOST_NO_CXX11_RVALUE_REFERENCES) && !defined(BOOST_NO_CXX11_DECLTYPE)
+  {
+    // a signal moved from is left like a new one
+    boost::signals2::signal<int ()> sig1;
+    sig1.connect(&return_one);
+    boost::signals2::signal<int ()> sig2(std::move(sig1));
+    BOOST_CHECK(sig1.null());
+    BOOST_CHECK(!sig1());
+    sig1.connect(&return_one);
+    BOOST_CHECK_EQUAL(sig1().get(), 1);
+  }
+#endif
+}
+
+void throw_expired_slot(int)
+{
+  throw boost::signals2::expired_slot();
+}
+
+// signals whose combiner only calls every slot call them directly
+template<typename Combiner>
+static void
+test_void_emission()
+{
+  typedef boost::signals2::signal<void (int), Combiner> signal_type;
+  signal_type sig;
+  boost::signals2::connection c1 = sig.connect(&log_value);
+  boost::signals2::connection expiring = sig.connect(&throw_expired_slot);
+  boost::signals2::connection c2 = sig.connect(&log_negated);
+  boost::shared_ptr<int> tracked(new int(0));
+  sig.connect(typename signal_type::slot_type(&log_value).track(tracked));
+  batch_log.clear();
+  sig(1);
+  // a slot throwing expired_slot is disconnected, and the rest still called
+  const int expected[] = {1, -1, 1};
+  BOOST_CHECK_EQUAL_COLLECTIONS(batch_log.begin(), batch_log.end(), expected, expected + 3);
+  BOOST_CHECK(expiring.connected() == false);
+  {
+    boost::signals2::shared_connection_block block(c1);
+    tracked.reset();
+    batch_log.clear();
+    sig(2);
+    BOOST_REQUIRE_EQUAL(batch_log.size(), 1u);
+    BOOST_CHECK_EQUAL(batch_log[0], -2);
+  }
+  BOOST_CHECK_EQUAL(sig.num_slots(), 2u);
+  const signal_type &const_sig = sig;
+  batch_log.clear();
+  const_sig(3);
+  BOOST_CHECK_EQUAL(batch_log.size(), 2u);
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   test_zero_args();
@@ -364,4 +643,9 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_set_combiner();
   test_swap();
   test_move();
+  test_num_slots();
+  test_emit_batch();
+  test_lazy_construction();
+  test_void_emission<boost::signals2::optional_last_value<void> >();
+  test_void_emission<boost::signals2::last_value<void> >();
 }
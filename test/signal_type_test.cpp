@@ -40,4 +40,35 @@ BOOST_AUTO_TEST_CASE(test_main)
     bs2::signal<float (long*)> mysig2;
     BOOST_CHECK(typeid(mysig) == typeid(mysig2));
   }
+
+  {
+    using namespace bs2::keywords;
+    bs2::signal_type<void (int), slot_storage_type<bs2::ungrouped_slot_storage> >::type mysig;
+    bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+      boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+      bs2::mutex, bs2::ungrouped_slot_storage> mysig2;
+    BOOST_CHECK(typeid(mysig) == typeid(mysig2));
+  }
+
+#if BOOST_PARAMETER_MAX_ARITY >= 9
+  {
+    using namespace bs2::keywords;
+    bs2::signal_type<void (int), allocator_type<bs2::pool_allocator<void> > >::type mysig;
+    bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+      boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+      bs2::mutex, bs2::vector_slot_storage, bs2::pool_allocator<void> > mysig2;
+    BOOST_CHECK(typeid(mysig) == typeid(mysig2));
+  }
+#endif
+
+#if BOOST_PARAMETER_MAX_ARITY >= 10
+  {
+    using namespace bs2::keywords;
+    bs2::signal_type<void (int), garbage_collection_type<bs2::deferred_garbage_collection> >::type mysig;
+    bs2::signal<void (int), bs2::optional_last_value<void>, int, std::less<int>,
+      boost::function<void (int)>, boost::function<void (const bs2::connection &, int)>,
+      bs2::mutex, bs2::vector_slot_storage, std::allocator<void>, bs2::deferred_garbage_collection> mysig2;
+    BOOST_CHECK(typeid(mysig) == typeid(mysig2));
+  }
+#endif
 }
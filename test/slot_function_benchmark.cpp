@@ -0,0 +1,97 @@
+/* Compares the cost of connecting and invoking slots held in
+  boost::function with slots held in signals2::inplace_function. */
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+#include <iostream>
+#include <boost/bind/bind.hpp>
+#include <boost/config.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/signals2.hpp>
+
+#if defined(BOOST_NO_CXX11_VARIADIC_TEMPLATES) || defined(BOOST_NO_CXX11_RVALUE_REFERENCES)
+int main()
+{
+  std::cout << "inplace_function requires C++11\n";
+  return 0;
+}
+#else
+
+using namespace boost::placeholders;
+
+class receiver
+{
+public:
+  receiver(): total(0) {}
+  void add(int x) {total += x;}
+  long total;
+};
+
+long free_total = 0;
+
+void free_add(int x)
+{
+  free_total += x;
+}
+
+typedef boost::signals2::signal<void (int)> function_signal_type;
+typedef boost::signals2::signal_type<void (int),
+  boost::signals2::keywords::slot_function_type<boost::signals2::inplace_function<void (int)> > >::type
+  inplace_signal_type;
+
+// a member function bound to a shared_ptr, which boost::function stores on the heap
+template<typename Signal>
+void connect_bound(Signal &sig, const boost::shared_ptr<receiver> &r)
+{
+  sig.connect(boost::bind(&receiver::add, r, _1));
+}
+
+template<typename Signal>
+void connect_free(Signal &sig, const boost::shared_ptr<receiver> &)
+{
+  sig.connect(&free_add);
+}
+
+template<typename Signal>
+void run(const char *name, void (*connect)(Signal &, const boost::shared_ptr<receiver> &),
+  unsigned num_connections)
+{
+  const boost::shared_ptr<receiver> r = boost::make_shared<receiver>();
+  Signal sig;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  for(unsigned i = 0; i < num_connections; ++i)
+  {
+    connect(sig, r);
+  }
+  boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+  const double connect_ns = double(elapsed.total_nanoseconds()) / num_connections;
+
+  const unsigned num_invocations = 10000000 / num_connections + 1;
+  start = boost::posix_time::microsec_clock::universal_time();
+  for(unsigned i = 0; i < num_invocations; ++i)
+  {
+    sig(1);
+  }
+  elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+  const double invoke_ns = double(elapsed.total_nanoseconds()) / (double(num_invocations) * num_connections);
+  std::cout << name << ": " << num_connections << " slots, "
+    << connect_ns << " ns per connect, "
+    << invoke_ns << " ns per slot invocation\n";
+}
+
+int main(int argc, const char **argv)
+{
+  const unsigned num_connections = argc > 1 ? std::strtol(argv[1], 0, 0) : 100;
+  run<function_signal_type>("boost::function, bound member  ", &connect_bound<function_signal_type>, num_connections);
+  run<inplace_signal_type>("inplace_function, bound member ", &connect_bound<inplace_signal_type>, num_connections);
+  run<function_signal_type>("boost::function, free function  ", &connect_free<function_signal_type>, num_connections);
+  run<inplace_signal_type>("inplace_function, free function ", &connect_free<inplace_signal_type>, num_connections);
+  return free_total == 0;
+}
+
+#endif
@@ -0,0 +1,99 @@
+/* Compares iterating through the slot list storage used by signals
+  (detail::grouped_vector) with the std::list based detail::grouped_list
+  it replaced. */
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/function.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/signals2/detail/grouped_vector.hpp>
+#include <boost/signals2/detail/slot_groups.hpp>
+
+namespace detail = boost::signals2::detail;
+
+typedef boost::shared_ptr<boost::function<void ()> > value_type;
+typedef detail::group_key<int>::type group_key_type;
+typedef detail::group_key_less<int, std::less<int> > group_key_compare_type;
+typedef detail::grouped_list<int, std::less<int>, value_type> list_type;
+typedef detail::grouped_vector<int, std::less<int>, value_type> vector_type;
+
+unsigned slot_calls = 0;
+
+void myslot()
+{
+  ++slot_calls;
+}
+
+template<typename Container>
+double connect_ns(Container &container, unsigned num_connections)
+{
+  // Interleave unrelated allocations with the connections, as happens
+  // in a real program, so the list nodes do not end up adjacent in memory.
+  std::vector<boost::shared_ptr<int> > clutter;
+  const group_key_type key(detail::back_ungrouped_slots, boost::optional<int>());
+  const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  for(unsigned i = 0; i < num_connections; ++i)
+  {
+    container.push_back(key, boost::make_shared<boost::function<void ()> >(&myslot));
+    clutter.push_back(boost::make_shared<int>(i));
+  }
+  const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+  return double(elapsed.total_nanoseconds()) / num_connections;
+}
+
+template<typename Container>
+double invoke_ns(Container &container, unsigned num_connections, unsigned num_invocations)
+{
+  const boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  for(unsigned i = 0; i < num_invocations; ++i)
+  {
+    typename Container::iterator it;
+    for(it = container.begin(); it != container.end(); ++it)
+    {
+      (**it)();
+    }
+  }
+  const boost::posix_time::time_duration elapsed = boost::posix_time::microsec_clock::universal_time() - start;
+  return double(elapsed.total_nanoseconds()) / (double(num_invocations) * num_connections);
+}
+
+template<typename Container>
+void run(const char *name, unsigned num_connections)
+{
+  Container container((group_key_compare_type()));
+  const double connect = connect_ns(container, num_connections);
+  const unsigned num_invocations = 10000000 / num_connections + 1;
+  const double invoke = invoke_ns(container, num_connections, num_invocations);
+  std::cout << name << ": " << num_connections << " slots, "
+    << connect << " ns per connect, "
+    << invoke << " ns per slot invocation\n";
+}
+
+int main(int argc, const char **argv)
+{
+  std::vector<unsigned> sizes;
+  for(int i = 1; i < argc; ++i)
+  {
+    sizes.push_back(std::strtol(argv[i], 0, 0));
+  }
+  if(sizes.empty())
+  {
+    sizes.push_back(50);
+    sizes.push_back(500);
+  }
+  for(unsigned i = 0; i < sizes.size(); ++i)
+  {
+    run<list_type>("grouped_list  ", sizes.at(i));
+    run<vector_type>("grouped_vector", sizes.at(i));
+  }
+  return slot_calls == 0;
+}
@@ -0,0 +1,123 @@
+// Tests for the slot list of small_slot_storage, which keeps its first
+// few slots inside itself
+
+// Copyright The Boost.Signals2 contributors 2026
+// Distributed under the Boost Software License, Version
+// 1.0. (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+
+// See http://www.boost.org/libs/signals2 for library home page.
+
+#include <boost/signals2.hpp>
+#include <boost/signals2/detail/small_vector.hpp>
+#define BOOST_TEST_MODULE small_vector_test
+#include <boost/test/included/unit_test.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+#include <cstdlib>
+#include <vector>
+
+namespace bs2 = boost::signals2;
+namespace detail = boost::signals2::detail;
+
+typedef detail::small_vector<boost::shared_ptr<int>, 4> vector_type;
+
+std::vector<int> values(const vector_type &v)
+{
+  std::vector<int> result;
+  for(vector_type::const_iterator it = v.begin(); it != v.end(); ++it)
+    result.push_back(**it);
+  BOOST_CHECK_EQUAL(result.size(), v.size());
+  return result;
+}
+
+BOOST_AUTO_TEST_CASE(test_against_vector)
+{
+  std::srand(42);
+  vector_type v;
+  std::vector<int> expected;
+  std::vector<vector_type> copies;
+  std::vector<std::vector<int> > copy_values;
+  for(int i = 0; i < 3000; ++i)
+  {
+    // stays around the size where the elements move to and from the heap
+    const int operation = std::rand() % 10;
+    if(operation < 5 && v.size() < 12)
+    {
+      const std::size_t position = std::rand() % (v.size() + 1);
+      v.insert(v.begin() + position, boost::make_shared<int>(i));
+      expected.insert(expected.begin() + position, i);
+    }else if(operation < 9 && v.size() > 0)
+    {
+      const std::size_t first = std::rand() % v.size();
+      const std::size_t last = first + 1 + std::rand() % (operation == 8 ? v.size() - first : 1);
+      v.erase(v.begin() + first, v.begin() + last);
+      expected.erase(expected.begin() + first, expected.begin() + last);
+    }else
+    {
+      v.clear();
+      expected.clear();
+    }
+    BOOST_REQUIRE(values(v) == expected);
+    if(i % 100 == 0)
+    {
+      copies.push_back(v);
+      copy_values.push_back(expected);
+    }
+  }
+  for(std::size_t i = 0; i < copies.size(); ++i)
+    BOOST_CHECK(values(copies[i]) == copy_values[i]);
+}
+
+BOOST_AUTO_TEST_CASE(test_element_lifetime)
+{
+  boost::shared_ptr<int> value = boost::make_shared<int>(0);
+  boost::weak_ptr<int> weak = value;
+  {
+    vector_type v;
+    for(int i = 0; i < 10; ++i)
+      v.push_back(value);
+    BOOST_CHECK_EQUAL(value.use_count(), 11);
+    // back into the buffer
+    v.erase(v.begin(), v.begin() + 8);
+    BOOST_CHECK_EQUAL(value.use_count(), 3);
+    const vector_type copy(v);
+    BOOST_CHECK_EQUAL(value.use_count(), 5);
+  }
+  BOOST_CHECK_EQUAL(value.use_count(), 1);
+  value.reset();
+  BOOST_CHECK(weak.expired());
+}
+
+int calls = 0;
+
+void count_call()
+{
+  ++calls;
+}
+
+typedef bs2::signal<void (), bs2::optional_last_value<void>, int, std::less<int>,
+  boost::function<void ()>, boost::function<void (const bs2::connection &)>,
+  bs2::mutex, bs2::small_slot_storage<2> > signal_type;
+
+BOOST_AUTO_TEST_CASE(test_signal)
+{
+  signal_type sig;
+  std::vector<bs2::connection> connections;
+  for(int i = 0; i < 5; ++i)
+  {
+    connections.push_back(sig.connect(&count_call));
+    calls = 0;
+    sig();
+    BOOST_CHECK_EQUAL(calls, i + 1);
+  }
+  for(int i = 4; i >= 0; --i)
+  {
+    connections[i].disconnect();
+    calls = 0;
+    sig();
+    BOOST_CHECK_EQUAL(calls, i);
+  }
+  BOOST_CHECK(sig.empty());
+}
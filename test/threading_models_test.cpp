@@ -13,6 +13,7 @@
 #define BOOST_TEST_MODULE threading_models_test
 #include <boost/test/included/unit_test.hpp>
 #include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
 
 // combiner that returns the number of slots invoked
 struct slot_counter {
@@ -72,6 +73,120 @@ public:
   }
 };
 
+// Boost.Test assertions are not thread safe, so count the failures
+template<typename signal_type>
+void concurrent_invoke(signal_type &sig, unsigned iterations, unsigned &failures)
+{
+  for(unsigned i = 0; i < iterations; ++i)
+  {
+    // the permanent slot is always seen
+    if(sig() < 1) ++failures;
+  }
+}
+
+template<typename signal_type>
+void concurrent_churn(signal_type &sig, unsigned iterations)
+{
+  for(unsigned i = 0; i < iterations; ++i)
+  {
+    boost::signals2::scoped_connection conn(sig.connect(&myslot));
+    boost::signals2::shared_connection_block block(conn, i % 3 == 0);
+    if(i % 2) conn.disconnect();
+  }
+}
+
+// connecting, blocking and disconnecting concurrently with invocations
+template<typename signal_type>
+void concurrent_test()
+{
+  signal_type sig;
+  sig.connect(&myslot);
+  unsigned failures1 = 0;
+  unsigned failures2 = 0;
+  boost::thread invoker1(concurrent_invoke<signal_type>, boost::ref(sig), 20000u, boost::ref(failures1));
+  boost::thread invoker2(concurrent_invoke<signal_type>, boost::ref(sig), 20000u, boost::ref(failures2));
+  boost::thread writer(concurrent_churn<signal_type>, boost::ref(sig), 2000u);
+  invoker1.join();
+  invoker2.join();
+  writer.join();
+  BOOST_CHECK(failures1 == 0);
+  BOOST_CHECK(failures2 == 0);
+  BOOST_CHECK(sig() == 1);
+  BOOST_CHECK(sig.num_slots() == 1);
+}
+
+template<typename signal_type>
+void connect_and_invoke(signal_type &sig, unsigned iterations, unsigned &failures)
+{
+  sig.connect(&myslot);
+  concurrent_invoke(sig, iterations, failures);
+}
+
+// threads racing to make the first connection to a signal, which creates
+// its internals, must all end up connected to the same slot list
+template<typename signal_type>
+void concurrent_first_connect_test()
+{
+  signal_type sig;
+  unsigned failures[3] = {0, 0, 0};
+  boost::thread thread1(connect_and_invoke<signal_type>, boost::ref(sig), 1000u, boost::ref(failures[0]));
+  boost::thread thread2(connect_and_invoke<signal_type>, boost::ref(sig), 1000u, boost::ref(failures[1]));
+  boost::thread thread3(connect_and_invoke<signal_type>, boost::ref(sig), 1000u, boost::ref(failures[2]));
+  thread1.join();
+  thread2.join();
+  thread3.join();
+  BOOST_CHECK(failures[0] == 0);
+  BOOST_CHECK(failures[1] == 0);
+  BOOST_CHECK(failures[2] == 0);
+  BOOST_CHECK(sig() == 3);
+  BOOST_CHECK(sig.num_slots() == 3);
+}
+
+struct disconnecting_slot
+{
+  void operator()(const boost::signals2::connection &conn) const
+  {
+    conn.disconnect();
+  }
+};
+
+// a single_threaded signal going through connecting, blocking, tracking and
+// disconnecting slots, including from inside an invocation
+void single_threaded_test()
+{
+  namespace bs2 = boost::signals2;
+  typedef bs2::signal_type<void (), bs2::keywords::combiner_type<slot_counter>,
+    bs2::keywords::mutex_type<bs2::single_threaded> >::type signal_type;
+  signal_type sig;
+  bs2::connection conn = sig.connect(&myslot);
+  BOOST_CHECK(sig() == 1);
+  {
+    bs2::shared_connection_block block(conn);
+    BOOST_CHECK(sig() == 0);
+  }
+  BOOST_CHECK(sig() == 1);
+  {
+    boost::shared_ptr<int> tracked(new int(0));
+    sig.connect(signal_type::slot_type(&myslot).track(tracked));
+    BOOST_CHECK(sig() == 2);
+  }
+  BOOST_CHECK(sig() == 1);
+  BOOST_CHECK(sig.num_slots() == 1);
+  sig.connect_extended(disconnecting_slot());
+  BOOST_CHECK(sig() == 2);
+  BOOST_CHECK(sig() == 1);
+  BOOST_CHECK(sig.num_slots() == 1);
+  conn.disconnect();
+  BOOST_CHECK(sig() == 0);
+  BOOST_CHECK(sig.empty());
+
+  // a void signal calls its slots without slot_call_iterators
+  bs2::signal_type<void (int), bs2::keywords::mutex_type<bs2::single_threaded> >::type void_sig;
+  void_sig.connect(boost::bind(&myslot));
+  void_sig(1);
+  BOOST_CHECK(void_sig.num_slots() == 1);
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   typedef boost::signals2::signal<void (), slot_counter, int, std::less<int>, boost::function<void ()>,
@@ -83,4 +198,16 @@ BOOST_AUTO_TEST_CASE(test_main)
   typedef boost::signals2::signal<void (), slot_counter, int, std::less<int>, boost::function<void ()>,
     boost::function<void (const boost::signals2::connection &)>, boost::signals2::dummy_mutex> sig0_st_type;
   simple_test<sig0_st_type>();
+  typedef boost::signals2::signal<void (), slot_counter, int, std::less<int>, boost::function<void ()>,
+    boost::function<void (const boost::signals2::connection &)>, boost::signals2::single_threaded> sig0_single_type;
+  simple_test<sig0_single_type>();
+  single_threaded_test();
+  concurrent_test<sig0_mt_type>();
+  concurrent_first_connect_test<sig0_mt_type>();
+  typedef boost::signals2::signal<void (), slot_counter, int, std::less<int>, boost::function<void ()>,
+    boost::function<void (const boost::signals2::connection &)>,
+    boost::signals2::rcu_mutex<boost::mutex> > sig0_rcu_type;
+  simple_test<sig0_rcu_type>();
+  concurrent_test<sig0_rcu_type>();
+  concurrent_first_connect_test<sig0_rcu_type>();
 }
@@ -10,6 +10,7 @@
 // For more information, see http://www.boost.org
 
 #include <memory>
+#include <vector>
 #include <boost/core/ref.hpp>
 #include <boost/optional.hpp>
 #include <boost/shared_ptr.hpp>
@@ -54,6 +55,35 @@ static int myfunc(int i, double z)
   return i;
 }
 
+#ifndef BOOST_NO_CXX11_SMART_PTR
+// a foreign weak pointer too large to be stored in place by the slot
+template<typename T>
+class fat_weak_ptr
+{
+public:
+  fat_weak_ptr(const std::shared_ptr<T> &p): _p(p)
+  {
+    for(unsigned i = 0; i < sizeof(_padding) / sizeof(_padding[0]); ++i) _padding[i] = i;
+  }
+  std::shared_ptr<T> lock() const {return _p.lock();}
+  bool expired() const {return _p.expired();}
+private:
+  std::weak_ptr<T> _p;
+  long _padding[16];
+};
+
+namespace boost
+{
+  namespace signals2
+  {
+    template<typename T> struct weak_ptr_traits<fat_weak_ptr<T> >
+    {
+      typedef std::shared_ptr<T> shared_type;
+    };
+  }
+}
+#endif
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   typedef boost::signals2::signal<int (int), max_or_default<int> > sig_type;
@@ -113,6 +143,29 @@ BOOST_AUTO_TEST_CASE(test_main)
   }
   BOOST_CHECK(s1(2) == 0);
 
+  // Test untracked slots mixed with a slot tracking more objects than
+  // fit in the invocation's tracked object buffer
+  {
+    std::vector<boost::shared_ptr<int> > shorties;
+    sig_type::slot_type slot(swallow(), static_cast<int*>(0), _1);
+    for(int i = 0; i < 12; ++i)
+    {
+      shorties.push_back(boost::shared_ptr<int>(new int(i)));
+      slot.track(shorties.back());
+    }
+    boost::signals2::connection untracked = s1.connect(sig_type::slot_type(&myfunc, _1, 0.));
+    connection = s1.connect(slot);
+    s1.connect(sig_type::slot_type(&myfunc, _1, 0.));
+    BOOST_CHECK(s1(6) == 6);
+    BOOST_CHECK(connection.connected());
+    shorties[11].reset();
+    BOOST_CHECK(s1(6) == 6);
+    BOOST_CHECK(connection.connected() == false);
+    BOOST_CHECK(untracked.connected());
+    s1.disconnect_all_slots();
+  }
+  BOOST_CHECK(s1(2) == 0);
+
 #ifndef BOOST_NO_CXX11_SMART_PTR
   // Test tracking through std::shared_ptr/weak_ptr
   BOOST_CHECK(s1(5) == 0);
@@ -163,5 +216,30 @@ BOOST_AUTO_TEST_CASE(test_main)
   }
   BOOST_CHECK(s1(5) == 0);
   BOOST_CHECK(s1(5) == 0);
+  // copies of slots tracking foreign pointers, which are held inline or on the heap
+  {
+    std::shared_ptr<int> shorty(new int());
+    std::shared_ptr<int> fatty(new int());
+    sig_type::slot_type slot(swallow(), shorty.get(), _1);
+    slot.track_foreign(shorty).track_foreign(fat_weak_ptr<int>(fatty));
+    sig_type::slot_type slot_copy(slot);
+    sig_type::slot_type slot_assigned(&myfunc, _1, 0.);
+    slot_assigned = slot;
+    s1.connect(slot_copy);
+    s1.connect(slot_assigned);
+    BOOST_CHECK_EQUAL(s1.num_slots(), 2u);
+    BOOST_CHECK(s1(6) == 6);
+    fatty.reset();
+    BOOST_CHECK(s1(6) == 0);
+    BOOST_CHECK(s1.empty());
+    BOOST_CHECK(slot.expired());
+    BOOST_CHECK(slot_copy.expired());
+  }
+  {
+    std::shared_ptr<int> fatty(new int());
+    s1.connect(sig_type::slot_type(swallow(), fatty.get(), _1).track_foreign(fat_weak_ptr<int>(fatty)));
+    BOOST_CHECK(s1(7) == 7);
+  }
+  BOOST_CHECK(s1(7) == 0);
 #endif
 }